@@ -110,6 +110,7 @@ int main(int argc, char** argv)
     auto type     = Bench::Float;
     auto use_cin  = false;
     auto buf_read = false;
+    auto block    = false;
     auto verbose  = false;
 
     app.add_option("type", type, "The type to bench")
@@ -117,6 +118,7 @@ int main(int argc, char** argv)
         ->transform(CLI::CheckedTransformer(TYPE_STR, CLI::ignore_case));
     app.add_flag("--cin", use_cin, "Use cin instead");
     app.add_flag("--buf", buf_read, "Use buffered read");
+    app.add_flag("--block", block, "Use buffered read with block reader (read(2))");
     app.add_flag("--verbose", verbose, "Print output");
 
     if (argc <= 1) {
@@ -131,6 +133,9 @@ int main(int argc, char** argv)
         if (use_cin) {
             auto reader = CinReader{};
             bench<int>(reader, verbose);
+        } else if (block) {
+            auto reader = linr::BlockReader{};
+            bench<int>(reader, verbose);
         } else if (buf_read) {
             auto reader = linr::BufReader{ 1024 };
             bench<int>(reader, verbose);
@@ -143,6 +148,9 @@ int main(int argc, char** argv)
         if (use_cin) {
             auto reader = CinReader{};
             bench<float>(reader, verbose);
+        } else if (block) {
+            auto reader = linr::BlockReader{};
+            bench<float>(reader, verbose);
         } else if (buf_read) {
             auto reader = linr::BufReader{ 1024 };
             bench<float>(reader, verbose);
@@ -0,0 +1,148 @@
+#ifndef LINR_BORROWED_HPP
+#define LINR_BORROWED_HPP
+
+#include "linr/common.hpp"
+
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace linr
+{
+    class Borrowed;
+
+    namespace detail
+    {
+        /**
+         * @brief Counts the lines read by a reader; a view borrowed from the reader is valid as long as the
+         * count doesn't change. Only used in debug builds (`NDEBUG` not defined).
+         */
+        class Epoch
+        {
+        public:
+#ifndef NDEBUG
+            Epoch()
+                : m_count{ std::make_shared<std::uint64_t>(0) }
+            {
+            }
+
+            // views borrowed before a move stay valid, the line buffer moves along with the reader; views
+            // borrowed from a moved-from reader are not checked
+            Epoch(Epoch&& other) noexcept
+                : m_count{ std::exchange(other.m_count, nullptr) }
+            {
+            }
+
+            Epoch& operator=(Epoch&& other) noexcept
+            {
+                advance();
+                m_count = std::exchange(other.m_count, nullptr);
+                return *this;
+            }
+
+            Epoch(const Epoch&)            = delete;
+            Epoch& operator=(const Epoch&) = delete;
+
+            ~Epoch() { advance(); }
+#endif
+
+            /**
+             * @brief Invalidate the views borrowed so far (a new line is read).
+             */
+            void advance() noexcept
+            {
+#ifndef NDEBUG
+                if (m_count) {
+                    ++*m_count;
+                }
+#endif
+            }
+
+            /**
+             * @brief Attach a borrowed view to the current line of the reader.
+             */
+            void lend(Borrowed& borrowed) const noexcept;
+
+#ifndef NDEBUG
+        private:
+            std::shared_ptr<std::uint64_t> m_count;
+#endif
+        };
+    }
+
+    /**
+     * @brief View of a value borrowed from the line buffer of a `BasicBufReader`, no copy or allocation.
+     *
+     * The view is valid until the next read from the same reader (or until the reader is destroyed). In
+     * debug builds (`NDEBUG` not defined), accessing the view after that fails an assertion. Borrowed values
+     * can only be read using `BasicBufReader`, the free read functions don't retain their line buffer.
+     */
+    class Borrowed
+    {
+    public:
+        Borrowed() = default;
+
+        explicit Borrowed(Str str) noexcept
+            : m_str{ str }
+        {
+        }
+
+        Str view() const noexcept
+        {
+#ifndef NDEBUG
+            assert((not m_count or *m_count == m_generation) and "borrowed view used after the next read");
+#endif
+            return m_str;
+        }
+
+        operator Str() const noexcept { return view(); }
+
+        const char* data() const noexcept { return view().data(); }
+        std::size_t size() const noexcept { return view().size(); }
+        bool        empty() const noexcept { return view().empty(); }
+
+        friend bool operator==(const Borrowed& lhs, Str rhs) noexcept { return lhs.view() == rhs; }
+
+    private:
+        friend class detail::Epoch;
+
+        Str m_str;
+
+#ifndef NDEBUG
+        std::shared_ptr<const std::uint64_t> m_count;
+        std::uint64_t                        m_generation = 0;
+#endif
+    };
+
+    inline void detail::Epoch::lend([[maybe_unused]] Borrowed& borrowed) const noexcept
+    {
+#ifndef NDEBUG
+        borrowed.m_count      = m_count;
+        borrowed.m_generation = m_count ? *m_count : 0;
+#endif
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Whether a type holds `Borrowed` views, specialized for aggregates (see `Reflectable`).
+         */
+        template <typename>
+        struct Borrows : std::false_type
+        {
+        };
+    }
+
+    /**
+     * @brief Types that own their value (anything but `Borrowed`, or an aggregate with `Borrowed` members),
+     * required by reads that don't retain their line buffer.
+     */
+    template <typename T>
+    concept Owned = not std::same_as<std::remove_cvref_t<T>, Borrowed>
+                and not detail::Borrows<std::remove_cvref_t<T>>::value;
+}
+
+#endif /* end of include guard: LINR_BORROWED_HPP */
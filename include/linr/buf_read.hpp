@@ -1,15 +1,38 @@
 #ifndef LINR_BUF_READER_HPP
 #define LINR_BUF_READER_HPP
 
+#include "linr/borrowed.hpp"
 #include "linr/common.hpp"
+#include "linr/detail/csv.hpp"
+#include "linr/detail/fixed_width.hpp"
+#include "linr/detail/format.hpp"
+#include "linr/detail/lending_reader.hpp"
 #include "linr/detail/read.hpp"
 #include "linr/parser.hpp"
 
+#if defined(__linux__) and defined(LINR_ENABLE_IO_URING)
+#    include "linr/detail/uring_reader.hpp"
+#endif
+
+#if (defined(__unix__) or defined(__APPLE__)) and (defined(LINR_ENABLE_ZLIB) or defined(LINR_ENABLE_ZSTD))
+#    include "linr/detail/decompress_reader.hpp"
+#endif
+
 #include <algorithm>
+#include <memory_resource>
 
 namespace linr
 {
-    class BufReader
+    /**
+     * @brief Reader that retains its underlying line reader (and its buffer) across reads.
+     *
+     * Since the line buffer is retained, values can be read as `Borrowed` views into it, which are valid
+     * until the next read.
+     *
+     * @tparam R The line reader backend.
+     */
+    template <detail::LineReader R>
+    class BasicBufReader
     {
     public:
         struct Line
@@ -18,41 +41,242 @@ namespace linr
             Str m_str;
         };
 
-        BufReader(std::size_t size) noexcept
-            : m_reader{ size }
+        template <typename... Args>
+            requires std::constructible_from<R, Args...>
+        BasicBufReader(Args&&... args) noexcept
+            : m_reader(std::forward<Args>(args)...)
         {
         }
 
         /**
          * @brief Read multiple values from stdin.
          *
+         * Fields can be skipped without being parsed using `Skip` or `Ignore<N>`, they are left out of the
+         * result.
+         *
          * @param prompt The prompt.
-         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
          */
-        template <Parseable... Ts>
+        template <detail::Projectable... Ts>
             requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
-        Results<Ts...> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+        Result<detail::Projected<Ts...>> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
         {
-            return detail::read_impl<Ts...>(m_reader, prompt, delim);
+            return lent(detail::read_impl<Ts...>(m_reader, prompt, delim));
         }
 
         /**
          * @brief Read a single value from stdin.
          *
+         * An aggregate is read member by member from consecutive fields (see `detail::Reflectable`), eg:
+         * `read<Point>()` for `struct Point { int x; float y; };`.
+         *
+         * @param prompt The prompt.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         */
+        template <detail::Readable T>
+            requires std::movable<T>
+        Result<T> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
+        {
+            auto result = lent(detail::read_impl<T>(m_reader, prompt, delim));
+            if (result) {
+                return make_result<T>(std::get<0>(std::move(result).value()));
+            }
+            return make_error<T>(result.error());
+        }
+
+        /**
+         * @brief Read every value of a line from stdin into a vector, eg: `read<std::vector<int>>()`.
+         *
+         * @param prompt The prompt.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         */
+        template <detail::ParseableVector V>
+            requires std::movable<typename V::value_type>
+        Result<V> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
+        {
+            auto values = V{};
+            auto result = detail::read_into_impl(m_reader, prompt, delim, values);
+            if (result) {
+                m_reader.lend(values);
+                return make_result<V>(std::move(values));
+            }
+            return make_error<V>(result.error());
+        }
+
+        /**
+         * @brief Read multiple values from stdin, allocator-aware values (eg: `std::pmr::string`) are
+         * allocated from a memory resource.
+         *
+         * @param arena The memory resource, eg: a `std::pmr::monotonic_buffer_resource` that frees a whole
+         * batch of reads at once. It must outlive the values.
+         * @param prompt The prompt.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         */
+        template <detail::Projectable... Ts>
+            requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
+        Result<detail::Projected<Ts...>> read(
+            std::pmr::memory_resource& arena,
+            Opt<Str>                   prompt = std::nullopt,
+            Delim                      delim  = ' '
+        ) noexcept
+        {
+            auto scope = detail::ScopedResource{ &arena };
+            return read<Ts...>(prompt, delim);
+        }
+
+        /**
+         * @brief Read a single value from stdin, allocator-aware values (eg: `std::pmr::string`) are
+         * allocated from a memory resource.
+         *
+         * @param arena The memory resource, it must outlive the value.
          * @param prompt The prompt.
-         * @param delim Delimiter, only `char` so you can't use unicode.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
          */
         template <Parseable T>
             requires std::movable<T>
-        Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+        Result<T> read(
+            std::pmr::memory_resource& arena,
+            Opt<Str>                   prompt = std::nullopt,
+            Delim                      delim  = ' '
+        ) noexcept
+        {
+            auto scope = detail::ScopedResource{ &arena };
+            return read<T>(prompt, delim);
+        }
+
+        /**
+         * @brief Read every value of a line from stdin into a `std::pmr::vector` allocated from a memory
+         * resource, eg: `read<std::pmr::vector<std::pmr::string>>(arena)`.
+         *
+         * @param arena The memory resource, it must outlive the vector.
+         * @param prompt The prompt.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         */
+        template <detail::ParseableVector V>
+            requires std::movable<typename V::value_type> and detail::PmrVector<V>
+        Result<V> read(
+            std::pmr::memory_resource& arena,
+            Opt<Str>                   prompt = std::nullopt,
+            Delim                      delim  = ' '
+        ) noexcept
         {
-            auto result = detail::read_impl<T>(m_reader, prompt, delim);
+            auto values = V{ &arena };
+            auto result = read_into(values, prompt, delim);
+            if (result) {
+                return make_result<V>(std::move(values));
+            }
+            return make_error<V>(result.error());
+        }
+
+        /**
+         * @brief Read every value of a line from stdin into a vector that is reused across calls.
+         *
+         * The vector is cleared before the line is parsed, its capacity is kept, so steady-state reads don't
+         * allocate. On a parse error, the values parsed before the failing field are kept; at EOF the vector
+         * is left as is.
+         *
+         * @param values The vector, allocator-aware values are allocated from its memory resource if it is a
+         * `std::pmr::vector`.
+         * @param prompt The prompt.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         * @return Number of values read or the error.
+         */
+        template <Parseable T, typename A>
+            requires std::movable<T>
+        Result<std::size_t> read_into(
+            std::vector<T, A>& values,
+            Opt<Str>           prompt = std::nullopt,
+            Delim              delim  = ' '
+        ) noexcept
+        {
+            auto result = detail::read_into_impl(m_reader, prompt, delim, values);
+            m_reader.lend(values);    // values parsed before an error are kept
+            return result;
+        }
+
+        /**
+         * @brief Read multiple values from stdin using a format string (see `FormatString`).
+         *
+         * The format is checked at compile time and a matcher specialized for it is generated.
+         *
+         * @tparam F The format, eg: `"{}, id:{}"`.
+         * @param prompt The prompt.
+         */
+        template <FormatString F, Parseable... Ts>
+            requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read(Opt<Str> prompt = std::nullopt) noexcept
+        {
+            return lent(detail::read_format_impl<F, Ts...>(m_reader, prompt));
+        }
+
+        /**
+         * @brief Read a single value from stdin using a format string (see `FormatString`).
+         *
+         * @tparam F The format, eg: `"id:{}"`.
+         * @param prompt The prompt.
+         */
+        template <FormatString F, Parseable T>
+            requires std::movable<T>
+        Result<T> read(Opt<Str> prompt = std::nullopt) noexcept
+        {
+            auto result = lent(detail::read_format_impl<F, T>(m_reader, prompt));
+            if (result) {
+                return make_result<T>(std::get<0>(std::move(result).value()));
+            }
+            return make_error<T>(result.error());
+        }
+
+        /**
+         * @brief Read multiple values from a fixed-width record on stdin (see `Field`).
+         *
+         * The columns are sliced at their compile-time offsets, the line isn't scanned for delimiters.
+         *
+         * @tparam Fs The columns, eg: `Field<int, 0, 8>, Field<double, 8, 12>`.
+         * @param prompt The prompt.
+         */
+        template <detail::FixedField... Fs>
+            requires (sizeof...(Fs) > 1) and (std::movable<typename Fs::Type> and ...)
+        Results<typename Fs::Type...> read_fixed(Opt<Str> prompt = std::nullopt) noexcept
+        {
+            return lent(detail::read_fixed_impl<Fs...>(m_reader, prompt));
+        }
+
+        /**
+         * @brief Read a single value from a fixed-width record on stdin (see `Field`).
+         *
+         * @tparam F The column, eg: `Field<int, 0, 8>`.
+         * @param prompt The prompt.
+         */
+        template <detail::FixedField F>
+            requires std::movable<typename F::Type>
+        Result<typename F::Type> read_fixed(Opt<Str> prompt = std::nullopt) noexcept
+        {
+            using T = typename F::Type;
+
+            auto result = lent(detail::read_fixed_impl<F>(m_reader, prompt));
             if (result) {
                 return make_result<T>(std::get<0>(std::move(result).value()));
             }
             return make_error<T>(result.error());
         }
 
+        /**
+         * @brief Read the first values of a CSV record (RFC 4180) from stdin.
+         *
+         * Quoted fields may contain delimiters, doubled quotes and newlines (the record then continues on the
+         * next lines). Fields after the last value are ignored. `Borrowed` values view the record, or the
+         * unescaped field if it has doubled quotes.
+         *
+         * @param prompt The prompt.
+         * @param delim The delimiter.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read_csv(Opt<Str> prompt = std::nullopt, char delim = ',') noexcept
+        {
+            return lent(detail::read_csv_impl<Ts...>(m_reader, prompt, delim, m_csv));
+        }
+
         /**
          * @brief Read a string until '\n' is found (aka getline)
          *
@@ -67,9 +291,89 @@ namespace linr
             return make_error<std::string>(result.error());
         }
 
+        /**
+         * @brief Read the rest of stdin into columns, one `std::vector` for each value of a line.
+         *
+         * Empty lines are skipped.
+         *
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+        Result<Tup<std::vector<Ts>...>> read_columns(Delim delim = ' ') noexcept
+        {
+            auto columns = Tup<std::vector<Ts>...>{};
+            auto result  = detail::read_columns_impl<Ts...>(m_reader, columns, delim);
+            if (result) {
+                return make_result<Tup<std::vector<Ts>...>>(std::move(columns));
+            }
+            return make_error<Tup<std::vector<Ts>...>>(result.error());
+        }
+
+        /**
+         * @brief Read the rest of stdin, appending each value of a line into its column.
+         *
+         * Empty lines are skipped.
+         *
+         * @param columns The columns, can be reused across calls.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         * @return Number of rows appended or the error that stops the read.
+         */
+        template <Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+        Result<std::size_t> read_columns(Tup<std::vector<Ts>...>& columns, Delim delim = ' ') noexcept
+        {
+            return detail::read_columns_impl<Ts...>(m_reader, columns, delim);
+        }
+
     private:
-        detail::BufReader m_reader;
+        template <typename T>
+        Result<T> lent(Result<T>&& result) noexcept
+        {
+            if (result) {
+                m_reader.lend(*result);
+            }
+            return std::move(result);
+        }
+
+        detail::LendingReader<R> m_reader;
+        detail::CsvBuffers       m_csv;
     };
+
+    using BufReader = BasicBufReader<detail::BufReader>;
+
+#if defined(__unix__) or defined(__APPLE__)
+    /**
+     * @brief Buffered reader that reads stdin in large blocks using `read(2)`, see `detail::BlockReader`.
+     */
+    using BlockReader = BasicBufReader<detail::BlockReader>;
+
+    /**
+     * @brief Buffered reader that reads stdin on a dedicated I/O thread, see `detail::PrefetchReader`.
+     */
+    using PrefetchReader = BasicBufReader<detail::PrefetchReader>;
+
+    /**
+     * @brief Buffered reader that maps stdin into memory when it is a regular file, see `detail::MappedReader`.
+     */
+    using MappedReader = BasicBufReader<detail::MappedReader>;
+#endif
+
+#if defined(__linux__) and defined(LINR_ENABLE_IO_URING)
+    /**
+     * @brief Buffered reader that keeps several reads of stdin in flight using `io_uring`, see
+     * `detail::UringReader`.
+     */
+    using UringReader = BasicBufReader<detail::UringReader>;
+#endif
+
+#if (defined(__unix__) or defined(__APPLE__)) and (defined(LINR_ENABLE_ZLIB) or defined(LINR_ENABLE_ZSTD))
+    /**
+     * @brief Buffered reader that decompresses gzip or zstd stdin on a dedicated I/O thread, see
+     * `detail::DecompressReader`.
+     */
+    using DecompressReader = BasicBufReader<detail::DecompressReader>;
+#endif
 }
 
 #endif /* end of include guard: LINR_BUF_READER_HPP */
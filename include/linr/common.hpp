@@ -93,37 +93,43 @@ namespace linr
 
         template <typename... Args>
             requires std::constructible_from<T, Args...>
-        Result(Args&&... args) noexcept
+        constexpr Result(Args&&... args) noexcept
             : m_value{ std::in_place_type<T>, std::forward<Args>(args)... }
         {
         }
 
-        Result(Error error) noexcept
+        constexpr Result(Error error) noexcept
             : m_value{ error }
         {
         }
 
-        T&&      value() && { return std::get<T>(std::move(m_value)); }
-        T&       value() & { return std::get<T>(m_value); }
-        const T& value() const& { return std::get<T>(m_value); }
+        constexpr T&&      value() && { return std::get<T>(std::move(m_value)); }
+        constexpr T&       value() & { return std::get<T>(m_value); }
+        constexpr const T& value() const& { return std::get<T>(m_value); }
 
-        T value_or(T&& defaultt) && noexcept { return *this ? std::move(std::get<T>(m_value)) : defaultt; }
-        const T& value_or(T&& defaultt) const& noexcept { return *this ? std::get<T>(m_value) : defaultt; }
+        constexpr T value_or(T&& defaultt) && noexcept
+        {
+            return *this ? std::move(std::get<T>(m_value)) : defaultt;
+        }
+        constexpr const T& value_or(T&& defaultt) const& noexcept
+        {
+            return *this ? std::get<T>(m_value) : defaultt;
+        }
 
-        Error&&      error() && { return std::get<Error>(std::move(m_value)); }
-        Error&       error() & { return std::get<Error>(m_value); }
-        const Error& error() const& { return std::get<Error>(m_value); }
+        constexpr Error&&      error() && { return std::get<Error>(std::move(m_value)); }
+        constexpr Error&       error() & { return std::get<Error>(m_value); }
+        constexpr const Error& error() const& { return std::get<Error>(m_value); }
 
-        bool has_value() const noexcept { return std::holds_alternative<T>(m_value); }
+        constexpr bool has_value() const noexcept { return std::holds_alternative<T>(m_value); }
 
-        explicit operator bool() const noexcept { return has_value(); }
+        constexpr explicit operator bool() const noexcept { return has_value(); }
 
-        T&&      operator*() && noexcept { return std::move(value()); }
-        T&       operator*() & noexcept { return value(); }
-        const T& operator*() const& noexcept { return value(); }
+        constexpr T&&      operator*() && noexcept { return std::move(value()); }
+        constexpr T&       operator*() & noexcept { return value(); }
+        constexpr const T& operator*() const& noexcept { return value(); }
 
-        T*       operator->() noexcept { return &value(); }
-        const T* operator->() const noexcept { return &value(); }
+        constexpr T*       operator->() noexcept { return &value(); }
+        constexpr const T* operator->() const noexcept { return &value(); }
 
     private:
         std::variant<T, Error> m_value;
@@ -134,7 +140,7 @@ namespace linr
     using Results = Result<Tup<Ts...>>;
 
     template <typename T, typename... Args>
-    Result<T> make_result(Args&&... args) noexcept
+    constexpr Result<T> make_result(Args&&... args) noexcept
     {
 #if defined(__cpp_lib_expected)
         return Result<T>{ std::in_place, std::forward<Args>(args)... };
@@ -144,7 +150,7 @@ namespace linr
     }
 
     template <typename T>
-    Result<T> make_error(Error error) noexcept
+    constexpr Result<T> make_error(Error error) noexcept
     {
 #if defined(__cpp_lib_expected)
         return Result<T>{ std::unexpect, error };
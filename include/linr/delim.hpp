@@ -0,0 +1,168 @@
+#ifndef LINR_DELIM_HPP
+#define LINR_DELIM_HPP
+
+#include "linr/common.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace linr
+{
+    /**
+     * @brief Delimiter between values of a line: a single character, a set of characters or a sequence.
+     *
+     * Implicitly constructible from `char`, so a plain character can be passed wherever a delimiter is
+     * expected. Sets (`any_of`, `whitespace`) are classified using lookup tables, 16 or 32 bytes at a time
+     * on x86 (SSSE3/AVX2 shuffles), so they cost about the same as a single character.
+     */
+    class Delim
+    {
+    public:
+        enum class Kind : std::uint8_t
+        {
+            Char,
+            Set,
+            Sequence,
+        };
+
+        using Nibbles = std::array<std::uint8_t, 16>;
+
+        constexpr Delim(char chr) noexcept
+            : m_kind{ Kind::Char }
+            , m_char{ chr }
+        {
+            add(chr);
+        }
+
+        /**
+         * @brief Any of the characters in a set is a delimiter.
+         *
+         * @param chars The set, must not be empty.
+         */
+        static constexpr Delim any_of(Str chars) noexcept
+        {
+            auto delim   = Delim{ chars.empty() ? '\0' : chars[0] };
+            delim.m_kind = chars.size() > 1 ? Kind::Set : Kind::Char;
+            for (auto chr : chars) {
+                delim.add(chr);
+            }
+            delim.build_nibbles();
+            return delim;
+        }
+
+        /**
+         * @brief Any ASCII whitespace character is a delimiter (like `std::isspace` in the "C" locale).
+         */
+        static constexpr Delim whitespace() noexcept { return any_of(" \t\n\v\f\r"); }
+
+        /**
+         * @brief A sequence of characters is a delimiter (eg: `"::"` or `", "`).
+         *
+         * @param seq The sequence, must not be empty. It is not copied, so it must outlive the delimiter.
+         */
+        static constexpr Delim sequence(Str seq) noexcept
+        {
+            auto delim = Delim{ seq.empty() ? '\0' : seq[0] };
+            if (seq.size() > 1) {
+                delim.m_kind     = Kind::Sequence;
+                delim.m_sequence = seq;
+            }
+            return delim;
+        }
+
+        constexpr Kind kind() const noexcept { return m_kind; }
+
+        /**
+         * @brief The delimiter character, or the first character of the set or the sequence.
+         */
+        constexpr char first() const noexcept { return m_char; }
+
+        constexpr Str sequence() const noexcept { return m_sequence; }
+
+        /**
+         * @brief Number of characters of a single delimiter.
+         */
+        constexpr std::size_t size() const noexcept
+        {
+            return m_kind == Kind::Sequence ? m_sequence.size() : 1;
+        }
+
+        /**
+         * @brief Check whether a character is in the set (the first character for a sequence).
+         */
+        constexpr bool contains(char chr) const noexcept
+        {
+            if (m_kind != Kind::Set) {
+                return chr == m_char;
+            }
+            auto byte = static_cast<unsigned char>(chr);
+            return (m_table[byte / 64] >> (byte % 64)) & 1;
+        }
+
+        /**
+         * @brief Check whether any character of this delimiter is a character of the other.
+         */
+        constexpr bool intersects(const Delim& other) const noexcept
+        {
+            auto result = std::uint64_t{ 0 };
+            for (std::size_t i = 0; i < m_table.size(); ++i) {
+                result |= m_table[i] & other.m_table[i];
+            }
+            return result != 0;
+        }
+
+        /**
+         * @brief Whether the set can be classified using the nibble tables (at most 8 distinct high nibbles).
+         */
+        constexpr bool has_nibbles() const noexcept { return m_has_nibbles; }
+
+        /**
+         * @brief Nibble tables: a byte is in the set iff `low[byte & 0xF] & high[byte >> 4]` is not zero.
+         */
+        constexpr const Nibbles& low_nibbles() const noexcept { return m_low; }
+        constexpr const Nibbles& high_nibbles() const noexcept { return m_high; }
+
+    private:
+        constexpr void add(char chr) noexcept
+        {
+            auto byte           = static_cast<unsigned char>(chr);
+            m_table[byte / 64] |= std::uint64_t{ 1 } << (byte % 64);
+        }
+
+        constexpr void build_nibbles() noexcept
+        {
+            // each distinct high nibble of the set gets its own bit
+            auto bits = std::array<std::uint8_t, 16>{};
+            auto next = 0;
+
+            for (std::size_t byte = 0; byte < 256; ++byte) {
+                if (not contains(static_cast<char>(byte))) {
+                    continue;
+                }
+
+                auto high = byte >> 4;
+                if (bits[high] == 0) {
+                    if (next == 8) {
+                        m_has_nibbles = false;
+                        return;
+                    }
+                    bits[high]   = static_cast<std::uint8_t>(1 << next++);
+                    m_high[high] = bits[high];
+                }
+                m_low[byte & 0xF] |= bits[high];
+            }
+
+            m_has_nibbles = true;
+        }
+
+        Kind                         m_kind;
+        char                         m_char;
+        bool                         m_has_nibbles = false;
+        Str                          m_sequence    = {};
+        std::array<std::uint64_t, 4> m_table       = {};
+        Nibbles                      m_low         = {};
+        Nibbles                      m_high        = {};
+    };
+}
+
+#endif /* end of include guard: LINR_DELIM_HPP */
@@ -0,0 +1,184 @@
+#ifndef LINR_DETAIL_AGGREGATE_HPP
+#define LINR_DETAIL_AGGREGATE_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/parser.hpp"
+#include "linr/skip.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace linr::detail
+{
+    // stands for a member in the brace initialization of an aggregate, only used in unevaluated contexts
+    struct AnyMember
+    {
+        template <typename T>
+        constexpr operator T() const noexcept;
+    };
+
+    template <typename T, std::size_t N>
+    inline constexpr bool brace_initializable = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return requires { T{ (static_cast<void>(Is), AnyMember{})... }; };
+    }(std::make_index_sequence<N>{});
+
+    // stands for a member in the initialization of an aggregate, but not for one of its base classes
+    template <typename T>
+    struct AnyDirectMember
+    {
+        template <typename U>
+            requires (not std::is_base_of_v<U, T>)
+        constexpr operator U() const noexcept;
+    };
+
+    // parenthesized aggregate initialization doesn't elide braces: each initializer is a direct member
+    template <typename T, std::size_t N>
+    inline constexpr bool paren_initializable = []<std::size_t... Is>(std::index_sequence<Is...>) {
+        return requires { T((static_cast<void>(Is), AnyDirectMember<T>{})...); };
+    }(std::make_index_sequence<N>{});
+
+    inline constexpr std::size_t max_members = 16;
+
+    /**
+     * @brief Number of members of an aggregate: the largest number of initializers it can be brace
+     * initialized with (`max_members + 1` if there are more).
+     */
+    template <typename T>
+    inline constexpr std::size_t member_count = [] {
+        auto count = std::size_t{ 0 };
+        [&]<std::size_t... Ns>(std::index_sequence<Ns...>) {
+            static_cast<void>(((brace_initializable<T, Ns + 1> and (++count, true)) and ...));
+        }(std::make_index_sequence<max_members + 1>{});
+        return count;
+    }();
+
+    /**
+     * @brief Tie the members of an aggregate into a tuple of references, in declaration order.
+     *
+     * `member_count` counts each element of a C-array member (brace elision) and a base class as one more
+     * member, so the aggregate is checked to be made of its `N` direct members only.
+     */
+    template <typename T, std::size_t N = member_count<T>>
+        requires (N >= 1) and (N <= max_members)
+    constexpr auto tie_members(T& value) noexcept
+    {
+        static_assert(paren_initializable<T, N>,
+                      "an aggregate with a C-array member or a base class can't be read member by member, it "
+                      "needs a CustomParser");
+
+        if constexpr (N == 1) {
+            auto& [m0] = value;
+            return std::tie(m0);
+        } else if constexpr (N == 2) {
+            auto& [m0, m1] = value;
+            return std::tie(m0, m1);
+        } else if constexpr (N == 3) {
+            auto& [m0, m1, m2] = value;
+            return std::tie(m0, m1, m2);
+        } else if constexpr (N == 4) {
+            auto& [m0, m1, m2, m3] = value;
+            return std::tie(m0, m1, m2, m3);
+        } else if constexpr (N == 5) {
+            auto& [m0, m1, m2, m3, m4] = value;
+            return std::tie(m0, m1, m2, m3, m4);
+        } else if constexpr (N == 6) {
+            auto& [m0, m1, m2, m3, m4, m5] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5);
+        } else if constexpr (N == 7) {
+            auto& [m0, m1, m2, m3, m4, m5, m6] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6);
+        } else if constexpr (N == 8) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+        } else if constexpr (N == 9) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+        } else if constexpr (N == 10) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+        } else if constexpr (N == 11) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+        } else if constexpr (N == 12) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+        } else if constexpr (N == 13) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+        } else if constexpr (N == 14) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+        } else if constexpr (N == 15) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+        } else if constexpr (N == 16) {
+            auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = value;
+            return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+        }
+    }
+
+    template <typename T>
+    using Members = decltype(tie_members(std::declval<T&>()));
+
+    template <typename>
+    struct ParseableMembers : std::false_type
+    {
+    };
+
+    template <typename M>
+    concept Member = Parseable<M> or CursorParseable<M>;
+
+    template <typename... Ms>
+    struct ParseableMembers<Tup<Ms&...>> : std::bool_constant<(Member<Ms> and ...)>
+    {
+    };
+
+    /**
+     * @brief Aggregate read member by member: each member is parsed in place from the next field, eg:
+     * `read<Point>()` for `struct Point { int x; float y; };` reads two fields.
+     *
+     * Up to `max_members` members, which must be `Parseable` or `CursorParseable`. Not supported (a
+     * `CustomParser` is needed instead): nested aggregates, C-array members, base classes, bit-fields and
+     * reference members. A type with a `CustomParser` is parsed by it instead.
+     */
+    template <typename T>
+    concept Reflectable = std::is_class_v<T> and std::is_aggregate_v<T> and not Parseable<T>
+                      and not CursorParseable<T> and std::default_initializable<T> and std::movable<T>
+                      and (member_count<T> >= 1) and (member_count<T> <= max_members)
+                      and ParseableMembers<Members<T>>::value;
+
+    /**
+     * @brief A value read from one field (`Parseable`) or from consecutive fields (`Reflectable`,
+     * `CursorParseable`).
+     */
+    template <typename T>
+    concept Readable = Parseable<T> or Reflectable<T> or CursorParseable<T>;
+
+    template <typename T>
+        requires Reflectable<T>
+    struct FieldWidth<T> : std::integral_constant<std::size_t, member_count<T>>
+    {
+    };
+
+    template <typename>
+    struct OwnedMembers : std::false_type
+    {
+    };
+
+    template <typename... Ms>
+    struct OwnedMembers<Tup<Ms&...>> : std::bool_constant<(Owned<Ms> and ...)>
+    {
+    };
+
+    template <typename T>
+        requires Reflectable<T>
+    struct Borrows<T> : std::bool_constant<not OwnedMembers<Members<T>>::value>
+    {
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_AGGREGATE_HPP */
@@ -0,0 +1,215 @@
+#ifndef LINR_DETAIL_BATCH_READER_HPP
+#define LINR_DETAIL_BATCH_READER_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/mpmc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace linr::detail
+{
+    /**
+     * @brief Lines of a batch, copied out of the line reader.
+     */
+    struct LineBatch
+    {
+        std::uint64_t            m_seq        = 0;
+        std::uint64_t            m_first_line = 0;
+        std::vector<char>        m_text;
+        std::vector<std::size_t> m_ends;    // end offset of each line in the text
+
+        std::size_t size() const noexcept { return m_ends.size(); }
+
+        /**
+         * @brief Call `fn(Str)` for each line of the batch, in order.
+         */
+        template <typename Fn>
+        void for_each(Fn&& fn) const noexcept
+        {
+            auto begin = std::size_t{ 0 };
+            for (auto end : m_ends) {
+                fn(Str{ m_text.data() + begin, end - begin });
+                begin = end;
+            }
+        }
+    };
+
+    /**
+     * @brief I/O stage shared by the multi-threaded readers: a dedicated thread reads stdin using a line
+     * reader and pushes batches of lines into a lock-free MPMC queue.
+     *
+     * The number of batches in flight (taken from stdin but not released yet) is capped, so the memory
+     * stays bounded on endless streams: the I/O thread waits once the cap is reached. Blocking uses atomic
+     * counters with wait/notify.
+     *
+     * @tparam R The line reader used by the I/O thread.
+     */
+    template <LineReader R>
+        requires std::default_initializable<R>
+    class BatchReader
+    {
+    public:
+        /**
+         * @param batch_lines Number of lines of a batch.
+         * @param max_in_flight Maximum number of batches read and not released yet.
+         */
+        BatchReader(std::size_t batch_lines, std::size_t max_in_flight)
+            : m_queue{ std::max<std::size_t>(max_in_flight, 1) }
+            , m_batch_lines{ std::max<std::size_t>(batch_lines, 1) }
+            , m_max_in_flight{ std::max<std::size_t>(max_in_flight, 1) }
+            , m_thread{ &BatchReader::produce, this }
+        {
+        }
+
+        ~BatchReader()
+        {
+            stop();
+            m_thread.join();
+        }
+
+        BatchReader(BatchReader&&)            = delete;
+        BatchReader& operator=(BatchReader&&) = delete;
+
+        BatchReader(const BatchReader&)            = delete;
+        BatchReader& operator=(const BatchReader&) = delete;
+
+        /**
+         * @brief Take the next batch, can be called from any number of threads. Blocks until a batch is
+         * available.
+         *
+         * @return The batch, or nothing once every line of stdin is taken (or the reader is stopped).
+         */
+        Opt<LineBatch> take() noexcept
+        {
+            while (true) {
+                // read the counter first so a push between the attempt and the wait isn't missed
+                auto pushed = m_pushed.load(std::memory_order_acquire);
+
+                if (m_stop.load(std::memory_order_acquire)) {
+                    return std::nullopt;
+                }
+                if (auto batch = m_queue.try_pop()) {
+                    return batch;
+                }
+                if (m_done.load(std::memory_order_acquire)) {
+                    return m_queue.try_pop();    // a batch may be pushed right before done
+                }
+
+                m_pushed.wait(pushed, std::memory_order_acquire);
+            }
+        }
+
+        /**
+         * @brief Release a taken batch, making room for the I/O thread to read another.
+         */
+        void release() noexcept
+        {
+            m_released.fetch_add(1, std::memory_order_release);
+            m_released.notify_one();
+        }
+
+        /**
+         * @brief Stop reading, waiting `take` calls return nothing.
+         *
+         * The I/O thread stops after the read it is blocked in, if any, returns.
+         */
+        void stop() noexcept
+        {
+            m_stop.store(true, std::memory_order_release);
+            wake(m_released);
+            wake(m_pushed);
+        }
+
+    private:
+        static void wake(std::atomic<std::uint64_t>& counter) noexcept
+        {
+            counter.fetch_add(1, std::memory_order_release);
+            counter.notify_all();
+        }
+
+        // wait until there is room for another batch in flight (`stop` bumps the released counter to wake the
+        // I/O thread up, which is fine since it stops)
+        bool wait_for_room(std::uint64_t pushed) noexcept
+        {
+            while (true) {
+                auto released = m_released.load(std::memory_order_acquire);
+
+                if (m_stop.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                if (pushed - released < m_max_in_flight) {
+                    return true;
+                }
+
+                m_released.wait(released, std::memory_order_acquire);
+            }
+        }
+
+        // the I/O thread: reads lines into batches until EOF
+        void produce() noexcept
+        {
+            auto reader = R{};
+            auto batch  = LineBatch{};
+            auto line   = std::uint64_t{ 0 };
+            auto seq    = std::uint64_t{ 0 };
+
+            const auto flush = [&] {
+                if (not wait_for_room(seq)) {
+                    return false;
+                }
+
+                batch.m_seq        = seq++;
+                batch.m_first_line = line;
+                line              += batch.size();
+
+                // can't fail: the queue holds as many batches as can be in flight
+                m_queue.try_push(batch);
+                wake(m_pushed);
+
+                batch = LineBatch{};
+                batch.m_ends.reserve(m_batch_lines);
+                return true;
+            };
+
+            batch.m_ends.reserve(m_batch_lines);
+            while (auto next = reader.readline()) {
+                // stopped while the read was blocked: the rest of the batch would never be delivered
+                if (m_stop.load(std::memory_order_acquire)) {
+                    break;
+                }
+
+                auto str = next->view();
+                batch.m_text.insert(batch.m_text.end(), str.begin(), str.end());
+                batch.m_ends.push_back(batch.m_text.size());
+
+                if (batch.size() == m_batch_lines and not flush()) {
+                    break;
+                }
+            }
+
+            if (batch.size() > 0 and not m_stop.load(std::memory_order_acquire)) {
+                flush();
+            }
+
+            m_done.store(true, std::memory_order_release);
+            wake(m_pushed);
+        }
+
+        MpmcQueue<LineBatch>       m_queue;
+        const std::size_t          m_batch_lines;
+        const std::size_t          m_max_in_flight;
+        std::atomic<std::uint64_t> m_pushed   = 0;
+        std::atomic<std::uint64_t> m_released = 0;
+        std::atomic<bool>          m_done     = false;
+        std::atomic<bool>          m_stop     = false;
+        std::thread                m_thread;    // last, it uses the members above
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_BATCH_READER_HPP */
@@ -0,0 +1,300 @@
+#ifndef LINR_DETAIL_CSV_HPP
+#define LINR_DETAIL_CSV_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/detail/scanner.hpp"
+#include "linr/parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace linr::detail
+{
+    namespace csv
+    {
+        inline constexpr std::size_t block_size = 64;
+
+        /**
+         * @brief Bitmasks of a block of 64 bytes, bit `i` represents byte `i` of the block.
+         */
+        struct Masks
+        {
+            std::uint64_t m_quote;
+            std::uint64_t m_delim;
+        };
+
+        inline Masks masks_scalar(const char* ptr, char delim) noexcept
+        {
+            auto masks = Masks{ 0, 0 };
+            for (std::size_t i = 0; i < block_size; ++i) {
+                masks.m_quote |= static_cast<std::uint64_t>(ptr[i] == '"') << i;
+                masks.m_delim |= static_cast<std::uint64_t>(ptr[i] == delim) << i;
+            }
+            return masks;
+        }
+
+        /**
+         * @brief Prefix XOR: bit `i` of the result is the parity of the bits `0..i`, so it is set for the
+         * bytes inside quotes (and the opening quotes) when given the quote mask.
+         */
+        constexpr std::uint64_t prefix_xor_scalar(std::uint64_t bits) noexcept
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+#if defined(LINR_SIMD_X86)
+        // the bits of a `movemask` result
+        constexpr std::uint64_t bits_of(int mask) noexcept { return static_cast<std::uint32_t>(mask); }
+
+        __attribute__((target("sse2"))) inline Masks masks_sse2(const char* ptr, char delim) noexcept
+        {
+            auto quotes = _mm_set1_epi8('"');
+            auto delims = _mm_set1_epi8(delim);
+            auto masks  = Masks{ 0, 0 };
+            for (std::size_t i = 0; i < block_size; i += 16) {
+                auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+                auto quote = _mm_cmpeq_epi8(block, quotes);
+                auto sep   = _mm_cmpeq_epi8(block, delims);
+
+                masks.m_quote |= bits_of(_mm_movemask_epi8(quote)) << i;
+                masks.m_delim |= bits_of(_mm_movemask_epi8(sep)) << i;
+            }
+            return masks;
+        }
+
+        __attribute__((target("avx2"))) inline Masks masks_avx2(const char* ptr, char delim) noexcept
+        {
+            auto quotes = _mm256_set1_epi8('"');
+            auto delims = _mm256_set1_epi8(delim);
+            auto masks  = Masks{ 0, 0 };
+            for (std::size_t i = 0; i < block_size; i += 32) {
+                auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i));
+                auto quote = _mm256_cmpeq_epi8(block, quotes);
+                auto sep   = _mm256_cmpeq_epi8(block, delims);
+
+                masks.m_quote |= bits_of(_mm256_movemask_epi8(quote)) << i;
+                masks.m_delim |= bits_of(_mm256_movemask_epi8(sep)) << i;
+            }
+            return masks;
+        }
+
+#    if defined(__x86_64__)
+        // carry-less multiplication by all ones: bit `i` of the product is the XOR of the bits `0..i`
+        __attribute__((target("pclmul"))) inline std::uint64_t prefix_xor_clmul(std::uint64_t bits) noexcept
+        {
+            auto value   = _mm_set_epi64x(0, static_cast<long long>(bits));
+            auto product = _mm_clmulepi64_si128(value, _mm_set1_epi8(-1), 0);
+            return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+        }
+#    endif
+#endif
+
+        /**
+         * @brief Block functions selected at runtime based on the CPU.
+         */
+        struct Kernel
+        {
+            using MasksFn     = Masks (*)(const char*, char) noexcept;
+            using PrefixXorFn = std::uint64_t (*)(std::uint64_t) noexcept;
+
+            MasksFn     m_masks;
+            PrefixXorFn m_prefix_xor;
+        };
+
+        inline const Kernel& kernel() noexcept
+        {
+#if defined(LINR_SIMD_X86)
+            static const auto avx2   = __builtin_cpu_supports("avx2") != 0;
+            static const auto masks  = avx2 ? masks_avx2 : masks_sse2;
+#    if defined(__x86_64__)
+            static const auto pclmul = __builtin_cpu_supports("pclmul") != 0;
+            static const auto kernel = Kernel{ masks, pclmul ? prefix_xor_clmul : prefix_xor_scalar };
+#    else
+            static const auto kernel = Kernel{ masks, prefix_xor_scalar };
+#    endif
+#else
+            static const auto kernel = Kernel{ masks_scalar, prefix_xor_scalar };
+#endif
+            return kernel;
+        }
+
+        /**
+         * @brief Check whether a string has an odd number of quotes (a record that doesn't end there).
+         */
+        inline bool odd_quotes(Str str) noexcept { return std::ranges::count(str, '"') % 2 != 0; }
+
+        /**
+         * @brief Remove the quotes of a quoted field.
+         *
+         * Doubled quotes are unescaped into `unescaped` (which must have room for it, so its views stay
+         * valid), as is the text after the closing quote of a malformed field. A field without quotes is
+         * returned as is.
+         */
+        inline Str unquote(Str field, std::string& unescaped) noexcept
+        {
+            if (field.empty() or field.front() != '"') {
+                return field;
+            }
+
+            auto inner = field.substr(1);
+            auto close = inner.find('"');
+            if (close == Str::npos) {
+                return inner;    // unterminated, the rest of the record
+            } else if (close == inner.size() - 1) {
+                return inner.substr(0, close);
+            }
+
+            auto begin  = unescaped.size();
+            auto quoted = true;
+            for (std::size_t i = 0; i < inner.size(); ++i) {
+                if (quoted and inner[i] == '"') {
+                    if (i + 1 < inner.size() and inner[i + 1] == '"') {
+                        unescaped.push_back('"');
+                        ++i;
+                    } else {
+                        quoted = false;
+                    }
+                } else {
+                    unescaped.push_back(inner[i]);
+                }
+            }
+            return Str{ unescaped }.substr(begin);
+        }
+    }
+
+    /**
+     * @brief Split a CSV record (RFC 4180) into its first `N` fields.
+     *
+     * The structure is found 64 bytes at a time: quotes and delimiters are classified into bitmasks, the
+     * prefix XOR of the quote mask (a carry-less multiplication by all ones) marks the bytes inside quotes,
+     * and the delimiters outside quotes end the fields. Only the quoted fields are looked at byte by byte.
+     * Scanning stops after the `N`-th field.
+     *
+     * @param record The record, newlines inside quotes included.
+     * @param delim The delimiter.
+     * @param unescaped Storage for the fields with doubled quotes, cleared first.
+     * @return The unquoted fields (views into the record or into `unescaped`), or nothing if the record has
+     * fewer than `N` fields.
+     */
+    template <std::size_t N>
+    Opt<std::array<Str, N>> split_csv(Str record, char delim, std::string& unescaped) noexcept
+    {
+        // an unescaped field is never longer than the record, the views into the storage stay valid
+        unescaped.clear();
+        unescaped.reserve(record.size());
+
+        auto fields = std::array<Str, N>{};
+        auto count  = std::size_t{ 0 };
+        auto start  = std::size_t{ 0 };
+
+        const auto& kernel = csv::kernel();
+
+        auto inside = std::uint64_t{ 0 };    // all ones if the previous block ends inside quotes
+        auto tail   = std::array<char, csv::block_size>{};
+
+        for (std::size_t pos = 0; pos < record.size() and count < N; pos += csv::block_size) {
+            const auto* ptr = record.data() + pos;
+            if (record.size() - pos < csv::block_size) {
+                // the tail is copied so no load goes past the end of the record
+                tail.fill('\0');
+                std::memcpy(tail.data(), ptr, record.size() - pos);
+                ptr = tail.data();
+            }
+
+            auto masks  = kernel.m_masks(ptr, delim);
+            auto quoted = kernel.m_prefix_xor(masks.m_quote) ^ inside;
+            inside      = 0 - (quoted >> 63);
+
+            auto ends = masks.m_delim & ~quoted;
+            if (pos + csv::block_size > record.size()) {
+                ends &= (std::uint64_t{ 1 } << (record.size() - pos)) - 1;
+            }
+
+            for (; ends != 0 and count < N; ends &= ends - 1) {
+                auto end        = pos + static_cast<std::size_t>(std::countr_zero(ends));
+                fields[count++] = csv::unquote(record.substr(start, end - start), unescaped);
+                start           = end + 1;
+            }
+        }
+
+        // the last field ends with the record
+        if (count < N) {
+            fields[count++] = csv::unquote(record.substr(start), unescaped);
+        }
+
+        if (count < N) {
+            return std::nullopt;
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Buffers of a CSV reader: the record that spans several lines and the unescaped fields.
+     */
+    struct CsvBuffers
+    {
+        std::string m_record;
+        std::string m_unescaped;
+    };
+
+    /**
+     * @brief Read a CSV record from a line reader and parse its first fields, see `split_csv`.
+     *
+     * A record continues on the next lines while a quote is open, the newlines are kept. A trailing CR is
+     * removed from the record.
+     */
+    template <Parseable... Ts, LineReader R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Results<Ts...> read_csv_impl(R& reader, Opt<Str> prompt, char delim, CsvBuffers& buffers) noexcept
+    {
+        // the line readers may leave NULs at the end of the line
+        const auto text_of = [](Str line) { return line.substr(0, line.find('\0')); };
+
+        const auto parse_fn = [&](Str line) {
+            auto record = text_of(line);
+
+            if (csv::odd_quotes(record)) {
+                // copied first, the next read may overwrite the line
+                buffers.m_record.assign(record);
+
+                auto open = true;
+                while (open) {
+                    auto next = reader.readline();
+                    if (not next) {
+                        break;    // unterminated quote, the record ends with the input
+                    }
+
+                    auto text = text_of(next->view());
+                    buffers.m_record.push_back('\n');
+                    buffers.m_record.append(text);
+                    open = open != csv::odd_quotes(text);
+                }
+                record = buffers.m_record;
+            }
+
+            if (record.ends_with('\r')) {
+                record.remove_suffix(1);
+            }
+
+            auto fields = split_csv<sizeof...(Ts)>(record, delim, buffers.m_unescaped);
+            if (not fields) {
+                return make_error<Tup<Ts...>>(Error::InvalidInput);
+            }
+            return parse_into_tuple<Ts...>(*fields);
+        };
+        return read_line_with<Tup<Ts...>>(reader, prompt, parse_fn);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_CSV_HPP */
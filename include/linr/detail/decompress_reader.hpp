@@ -0,0 +1,301 @@
+#ifndef LINR_DETAIL_DECOMPRESS_READER_HPP
+#define LINR_DETAIL_DECOMPRESS_READER_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#if defined(LINR_ENABLE_ZLIB)
+#    include <zlib.h>
+#endif
+
+#if defined(LINR_ENABLE_ZSTD)
+#    include <zstd.h>
+#endif
+
+namespace linr::detail
+{
+    enum class Compression
+    {
+        None,
+        Gzip,
+        Zstd,
+    };
+
+    /**
+     * @brief Detect the compression format from the magic bytes at the start of the input.
+     *
+     * Formats whose support is not compiled in are reported as `None`.
+     */
+    constexpr Compression detect_compression([[maybe_unused]] Str head) noexcept
+    {
+#if defined(LINR_ENABLE_ZLIB)
+        if (head.starts_with("\x1f\x8b")) {
+            return Compression::Gzip;
+        }
+#endif
+#if defined(LINR_ENABLE_ZSTD)
+        if (head.starts_with("\x28\xb5\x2f\xfd")) {
+            return Compression::Zstd;
+        }
+#endif
+        return Compression::None;
+    }
+
+    /**
+     * @brief Compressed bytes read from a block source (stdin) in large blocks, consumed by the decoders.
+     *
+     * @tparam Source The block source, see `BlockSource`.
+     */
+    template <BlockSource Source>
+    class BasicCompressedInput
+    {
+    public:
+        static constexpr std::size_t block_size = 256 * 1024;
+
+        explicit BasicCompressedInput(Source source = {})
+            : m_buf{ std::make_unique_for_overwrite<char[]>(block_size) }
+            , m_source{ std::move(source) }
+        {
+        }
+
+        /**
+         * @brief The bytes read and not consumed yet.
+         */
+        Str pending() const noexcept { return { m_buf.get() + m_begin, m_end - m_begin }; }
+
+        void consume(std::size_t size) noexcept { m_begin += size; }
+
+        /**
+         * @brief Read more bytes from the source after the pending ones, returns false at EOF.
+         */
+        bool fill() noexcept
+        {
+            std::memmove(m_buf.get(), m_buf.get() + m_begin, m_end - m_begin);
+            m_end   -= m_begin;
+            m_begin  = 0;
+
+            auto size  = m_source.read(m_buf.get() + m_end, block_size - m_end);
+            m_end     += size;
+            return size > 0;
+        }
+
+        /**
+         * @brief Read the input as is: the pending bytes first, then straight from the source.
+         */
+        std::size_t read(char* out, std::size_t size) noexcept
+        {
+            if (m_begin == m_end) {
+                return m_source.read(out, size);
+            }
+
+            size = std::min(size, m_end - m_begin);
+            std::memcpy(out, m_buf.get() + m_begin, size);
+            m_begin += size;
+            return size;
+        }
+
+    private:
+        std::unique_ptr<char[]> m_buf;
+        std::size_t             m_begin = 0;
+        std::size_t             m_end   = 0;
+        Source                  m_source;
+    };
+
+    using CompressedInput = BasicCompressedInput<StdinSource>;
+
+#if defined(LINR_ENABLE_ZLIB)
+    /**
+     * @brief gzip decoder (zlib), concatenated members (pigz, `cat a.gz b.gz`) are decoded in sequence.
+     */
+    class GzipDecoder
+    {
+    public:
+        GzipDecoder() noexcept
+            : m_init{ inflateInit2(&m_stream, 15 + 16) == Z_OK }    // 16: gzip header and trailer
+            , m_done{ not m_init }
+        {
+        }
+
+        ~GzipDecoder()
+        {
+            if (m_init) {
+                inflateEnd(&m_stream);
+            }
+        }
+
+        // zlib keeps a pointer to the stream
+        GzipDecoder(GzipDecoder&&)            = delete;
+        GzipDecoder& operator=(GzipDecoder&&) = delete;
+
+        GzipDecoder(const GzipDecoder&)            = delete;
+        GzipDecoder& operator=(const GzipDecoder&) = delete;
+
+        /**
+         * @brief Decompress into `out`, returns the number of bytes written, 0 at the end of the stream.
+         *
+         * Only blocks on stdin while nothing is decompressed yet, so the lines of a slow stream aren't held.
+         */
+        template <BlockSource Source>
+        std::size_t decode(BasicCompressedInput<Source>& input, char* out, std::size_t size) noexcept
+        {
+            size = std::min<std::size_t>(size, std::numeric_limits<uInt>::max());
+
+            m_stream.next_out  = reinterpret_cast<Bytef*>(out);
+            m_stream.avail_out = static_cast<uInt>(size);
+
+            while (not m_done and m_stream.avail_out > 0) {
+                auto in           = input.pending();    // at most a block, fits in `uInt`
+                m_stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+                m_stream.avail_in = static_cast<uInt>(in.size());
+
+                auto ret      = inflate(&m_stream, Z_NO_FLUSH);
+                auto produced = size - m_stream.avail_out;
+                input.consume(in.size() - m_stream.avail_in);
+
+                if (ret == Z_STREAM_END) {
+                    // another member may follow
+                    auto more = not input.pending().empty() or input.fill();
+                    m_done    = not more or inflateReset(&m_stream) != Z_OK;
+                } else if (ret == Z_BUF_ERROR) {
+                    // more input is needed, a truncated stream ends here
+                    if (produced > 0) {
+                        break;
+                    }
+                    m_done = not input.fill();
+                } else if (ret != Z_OK) {
+                    m_done = true;    // corrupted, or trailing garbage
+                }
+            }
+
+            return size - m_stream.avail_out;
+        }
+
+    private:
+        z_stream m_stream = {};
+        bool     m_init;
+        bool     m_done;
+    };
+#endif
+
+#if defined(LINR_ENABLE_ZSTD)
+    /**
+     * @brief zstd decoder (libzstd), consecutive frames are decoded in sequence.
+     */
+    class ZstdDecoder
+    {
+    public:
+        /**
+         * @brief Decompress into `out`, returns the number of bytes written, 0 at the end of the stream.
+         *
+         * Only blocks on stdin while nothing is decompressed yet, so the lines of a slow stream aren't held.
+         */
+        template <BlockSource Source>
+        std::size_t decode(BasicCompressedInput<Source>& input, char* out, std::size_t size) noexcept
+        {
+            auto output = ZSTD_outBuffer{ out, size, 0 };
+
+            while (m_ctx and not m_done and output.pos < output.size) {
+                auto in     = input.pending();
+                auto buffer = ZSTD_inBuffer{ in.data(), in.size(), 0 };
+                auto before = output.pos;
+                auto ret    = ZSTD_decompressStream(m_ctx.get(), &output, &buffer);
+                input.consume(buffer.pos);
+
+                if (ZSTD_isError(ret)) {
+                    m_done = true;    // corrupted, or trailing garbage
+                } else if (output.pos == before and input.pending().empty()) {
+                    // more input is needed, a truncated stream ends here
+                    if (output.pos > 0) {
+                        break;
+                    }
+                    m_done = not input.fill();
+                }
+            }
+
+            return output.pos;
+        }
+
+    private:
+        struct FreeContext
+        {
+            void operator()(ZSTD_DCtx* ctx) const noexcept { ZSTD_freeDCtx(ctx); }
+        };
+
+        std::unique_ptr<ZSTD_DCtx, FreeContext> m_ctx{ ZSTD_createDCtx() };
+        bool                                    m_done = false;
+    };
+#endif
+
+    /**
+     * @brief Block source that decompresses stdin on the fly, the format is detected from its first bytes.
+     *
+     * gzip needs zlib (`LINR_ENABLE_ZLIB`) and zstd needs libzstd (`LINR_ENABLE_ZSTD`). Input in another
+     * format, or in a format whose support isn't compiled in, is passed through as is. Like a read error,
+     * corrupted data ends the input.
+     *
+     * @tparam Source The block source of the compressed input, see `BlockSource`.
+     */
+    template <BlockSource Source>
+    class BasicDecompressSource
+    {
+    public:
+        BasicDecompressSource() = default;
+
+        explicit BasicDecompressSource(Source source)
+            : m_input{ std::move(source) }
+        {
+        }
+
+        std::size_t read(char* out, std::size_t size) noexcept
+        {
+            if (not m_compression) {
+                // a pipe may deliver the magic bytes in several reads
+                while (m_input.pending().size() < 4 and m_input.fill()) { }
+                m_compression = detect_compression(m_input.pending());
+            }
+
+#if defined(LINR_ENABLE_ZLIB)
+            if (*m_compression == Compression::Gzip) {
+                return m_gzip.decode(m_input, out, size);
+            }
+#endif
+#if defined(LINR_ENABLE_ZSTD)
+            if (*m_compression == Compression::Zstd) {
+                return m_zstd.decode(m_input, out, size);
+            }
+#endif
+            return m_input.read(out, size);
+        }
+
+    private:
+        BasicCompressedInput<Source> m_input;
+        Opt<Compression>             m_compression;
+#if defined(LINR_ENABLE_ZLIB)
+        GzipDecoder m_gzip;
+#endif
+#if defined(LINR_ENABLE_ZSTD)
+        ZstdDecoder m_zstd;
+#endif
+    };
+
+    using DecompressSource = BasicDecompressSource<StdinSource>;
+    static_assert(BlockSource<DecompressSource>);
+
+    /**
+     * @brief Line reader that decompresses stdin on a dedicated I/O thread, see `BasicPrefetchReader` and
+     * `DecompressSource`.
+     *
+     * The decompressed blocks go straight into the line splitting, without an extra `zcat |` process and
+     * the copy through its pipe.
+     */
+    using DecompressReader = BasicPrefetchReader<DecompressSource>;
+    static_assert(LineReader<DecompressReader>);
+}
+
+#endif /* end of include guard: LINR_DETAIL_DECOMPRESS_READER_HPP */
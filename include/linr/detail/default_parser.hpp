@@ -1,7 +1,12 @@
 #ifndef LINR_DETAIL_DEFAULT_PARSER_HPP
 #define LINR_DETAIL_DEFAULT_PARSER_HPP
 
+#include "linr/borrowed.hpp"
 #include "linr/common.hpp"
+#include "linr/fixed_string.hpp"
+#include "linr/detail/float_parser.hpp"
+#include "linr/detail/int_parser.hpp"
+#include "linr/detail/memory.hpp"
 
 #include <array>
 #include <cctype>
@@ -17,17 +22,22 @@ namespace linr::detail
     template <>
     struct DefaultParser<char>
     {
-        Result<char> parse(Str str) const noexcept { return str[0]; }
+        constexpr Result<char> parse(Str str) const noexcept { return str[0]; }
     };
 
     // specialization for boolean
     template <>
     struct DefaultParser<bool>
     {
-        Result<bool> parse(Str str) const noexcept
+        constexpr Result<bool> parse(Str str) const noexcept
         {
             using Buf = std::array<char, 6>;
 
+            // `std::tolower` is not constexpr
+            constexpr auto lower = [](char chr) {
+                return chr >= 'A' and chr <= 'Z' ? static_cast<char>(chr - 'A' + 'a') : chr;
+            };
+
             constexpr auto lit_false = Buf{ "false" };
             constexpr auto lit_true  = Buf{ "true" };
 
@@ -35,7 +45,7 @@ namespace linr::detail
 
             auto size = std::min(str.size(), buf.size());
             for (std::size_t i = 0; i < size; ++i) {
-                buf[i] = static_cast<char>(std::tolower(str[i]));
+                buf[i] = lower(str[i]);
             }
 
             if (buf[0] == '0') {
@@ -59,30 +69,98 @@ namespace linr::detail
         requires std::is_fundamental_v<T>
     struct DefaultParser<T>
     {
-        Result<T> parse(Str str) const noexcept
+        constexpr Result<T> parse(Str str) const noexcept
         {
             T value;
-            auto [ptr, ec] = std::from_chars(str.begin(), str.end(), value);
+            auto [ptr, ec] = parse_prefix(str.data(), str.data() + str.size(), value);
 
-            if (ec == std::errc::invalid_argument) {
-                return make_error<T>(Error::InvalidInput);
-            } else if (ec == std::errc::result_out_of_range) {
+            if (ec == std::errc::result_out_of_range) {
                 return make_error<T>(Error::OutOfRange);
+            } else if (ec != std::errc{}) {
+                return make_error<T>(Error::InvalidInput);
+            } else if (ptr != str.data() + str.size()) {
+                // trailing characters that are not part of the number
+                return make_error<T>(Error::InvalidInput);
             }
 
             return value;
         }
+
+        /**
+         * @brief Parse the number at the start of the string, has the same contract as `std::from_chars`.
+         *
+         * Unlike `parse`, characters after the number are left for the caller to check. In constant
+         * evaluation, `parse_int` and `parse_float` are used whatever the build flags.
+         */
+        constexpr std::from_chars_result parse_prefix(
+            const char* first,
+            const char* last,
+            T&          value
+        ) const noexcept
+        {
+            // `std::from_chars` is not constexpr
+            if (std::is_constant_evaluated()) {
+                if constexpr (std::integral<T>) {
+                    return parse_int(first, last, value);
+                } else if constexpr (std::same_as<T, float> or std::same_as<T, double>) {
+                    return parse_float(first, last, value);
+                }
+            }
+
+#if defined(LINR_ENABLE_FAST_INT)
+            if constexpr (std::integral<T>) {
+                return parse_int(first, last, value);
+            }
+#endif
+#if defined(LINR_ENABLE_FAST_FLOAT)
+            if constexpr (std::same_as<T, float> or std::same_as<T, double>) {
+                return parse_float(first, last, value);
+            }
+#endif
+            return std::from_chars(first, last, value);
+        }
     };
 
     // specialization for std::string
     template <>
     struct DefaultParser<std::string>
     {
-        Result<std::string> parse(Str str) const noexcept
+        constexpr Result<std::string> parse(Str str) const noexcept
         {
             return make_result<std::string>(str.begin(), str.size());
         }
     };
+
+    // specialization for std::pmr::string, allocated from the current memory resource (see `ScopedResource`)
+    template <>
+    struct DefaultParser<std::pmr::string>
+    {
+        Result<std::pmr::string> parse(Str str) const noexcept
+        {
+            return make_result<std::pmr::string>(str.begin(), str.size(), current_resource());
+        }
+    };
+
+    // specialization for inline strings
+    template <std::size_t N>
+    struct DefaultParser<FixedString<N>>
+    {
+        constexpr Result<FixedString<N>> parse(Str str) const noexcept
+        {
+            auto value = FixedString<N>{};
+            if (not value.assign(str)) {
+                return make_error<FixedString<N>>(Error::OutOfRange);
+            }
+            return make_result<FixedString<N>>(value);
+        }
+    };
+
+    // specialization for views into the line buffer, see `BasicBufReader`
+    template <>
+    struct DefaultParser<Borrowed>
+    {
+        Result<Borrowed> parse(Str str) const noexcept { return make_result<Borrowed>(str); }
+    };
 }
 
 #endif /* end of include guard: LINR_DETAIL_DEFAULT_PARSER_HPP */
@@ -0,0 +1,147 @@
+#ifndef LINR_DETAIL_FIXED_WIDTH_HPP
+#define LINR_DETAIL_FIXED_WIDTH_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+
+namespace linr
+{
+    /**
+     * @brief Column of a fixed-width record: the value at `[Offset, Offset + Width)` of the line, used as a
+     * template argument.
+     *
+     * eg: `linr::read_fixed<linr::Field<int, 0, 8>, linr::Field<double, 8, 12>>()`
+     *
+     * Padding spaces around the value are trimmed before it is parsed. The part of a column past the end of
+     * the line is treated as padding, so trailing spaces may be missing from the line. Columns may be listed
+     * in any order.
+     *
+     * @tparam T The type of the value.
+     * @tparam Offset Offset of the column from the start of the line.
+     * @tparam Width Width of the column.
+     */
+    template <Parseable T, std::size_t Offset, std::size_t Width>
+        requires (Width >= 1)
+    struct Field
+    {
+        using Type = T;
+
+        static constexpr std::size_t offset = Offset;
+        static constexpr std::size_t width  = Width;
+    };
+
+    namespace detail
+    {
+        template <typename>
+        struct IsField : std::false_type
+        {
+        };
+
+        template <typename T, std::size_t Offset, std::size_t Width>
+        struct IsField<Field<T, Offset, Width>> : std::true_type
+        {
+        };
+
+        template <typename F>
+        concept FixedField = IsField<F>::value;
+
+        // the line readers may leave NULs (or the newline) at the end of the line
+        constexpr bool is_padding(char chr) noexcept { return chr == ' ' or chr == '\0' or chr == '\n'; }
+
+        /**
+         * @brief The text of a column with its padding trimmed.
+         */
+        template <FixedField F>
+        constexpr Str column_of(Str line) noexcept
+        {
+            if (F::offset >= line.size()) {
+                return {};
+            }
+
+            auto column = line.substr(F::offset, F::width);
+            auto begin  = std::size_t{ 0 };
+            auto end    = column.size();
+            while (begin < end and is_padding(column[begin])) {
+                ++begin;
+            }
+            while (end > begin and is_padding(column[end - 1])) {
+                --end;
+            }
+            return column.substr(begin, end - begin);
+        }
+
+        /**
+         * @brief Parse a fixed-width record: each column is sliced at its compile-time offset and parsed, the
+         * line is never scanned for delimiters.
+         *
+         * Default initializable values are parsed in place (numbers straight from the line), others are
+         * parsed with `parse_into_tuple`. A trailing CR is ignored (see `line_text`).
+         *
+         * @param line The line to be parsed.
+         */
+        template <FixedField... Fs>
+            requires (sizeof...(Fs) >= 1) and (std::movable<typename Fs::Type> and ...)
+        Results<typename Fs::Type...> parse_fixed(Str line) noexcept
+        {
+            using Values = Tup<typename Fs::Type...>;
+
+            line = line_text(line);
+
+            if constexpr ((std::default_initializable<typename Fs::Type> and ...)) {
+                auto values = Values{};
+                auto error  = Opt<Error>{};
+
+                auto parse_next = [&]<std::size_t I, typename F>() {
+                    using T = typename F::Type;
+
+                    auto  column = column_of<F>(line);
+                    auto& value  = std::get<I>(values);
+
+                    if constexpr (PrefixParseable<T>) {
+                        auto end       = column.data() + column.size();
+                        auto [ptr, ec] = DefaultParser<T>{}.parse_prefix(column.data(), end, value);
+                        if (ec == std::errc::result_out_of_range) {
+                            error = Error::OutOfRange;
+                        } else if (ec != std::errc{} or ptr != end) {
+                            error = Error::InvalidInput;
+                        }
+                    } else if (auto result = parse<T>(column)) {
+                        value = std::move(result).value();
+                    } else {
+                        error = result.error();
+                    }
+                    return not error;
+                };
+
+                auto parsed = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    return (parse_next.template operator()<Is, Fs>() and ...);
+                }(std::index_sequence_for<Fs...>{});
+
+                if (not parsed) {
+                    return make_error<Values>(*error);
+                }
+                return make_result<Values>(std::move(values));
+            } else {
+                auto columns = std::array<Str, sizeof...(Fs)>{ column_of<Fs>(line)... };
+                return parse_into_tuple<typename Fs::Type...>(columns);
+            }
+        }
+
+        template <FixedField... Fs, LineReader R>
+            requires (sizeof...(Fs) >= 1) and (std::movable<typename Fs::Type> and ...)
+        Results<typename Fs::Type...> read_fixed_impl(R& reader, Opt<Str> prompt) noexcept
+        {
+            const auto parse_fn = [](Str line) { return parse_fixed<Fs...>(line); };
+            return read_line_with<Tup<typename Fs::Type...>>(reader, prompt, parse_fn);
+        }
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_FIXED_WIDTH_HPP */
@@ -0,0 +1,296 @@
+#ifndef LINR_DETAIL_FLOAT_PARSER_HPP
+#define LINR_DETAIL_FLOAT_PARSER_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/int_parser.hpp"
+#include "linr/detail/powers_of_five.hpp"
+
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+
+namespace linr::detail
+{
+    namespace eisel_lemire
+    {
+        struct U128
+        {
+            std::uint64_t m_high;
+            std::uint64_t m_low;
+        };
+
+        constexpr U128 mul(std::uint64_t lhs, std::uint64_t rhs) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            auto product = static_cast<unsigned __int128>(lhs) * rhs;
+            return { static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product) };
+#else
+            auto lo_lo = (lhs & 0xFFFF'FFFF) * (rhs & 0xFFFF'FFFF);
+            auto hi_lo = (lhs >> 32) * (rhs & 0xFFFF'FFFF);
+            auto lo_hi = (lhs & 0xFFFF'FFFF) * (rhs >> 32);
+            auto hi_hi = (lhs >> 32) * (rhs >> 32);
+
+            auto cross = (lo_lo >> 32) + (hi_lo & 0xFFFF'FFFF) + lo_hi;
+            auto high  = hi_hi + (hi_lo >> 32) + (cross >> 32);
+            return { high, (cross << 32) | (lo_lo & 0xFFFF'FFFF) };
+#endif
+        }
+
+        template <std::floating_point T>
+        struct Format;
+
+        template <>
+        struct Format<double>
+        {
+            using Bits = std::uint64_t;
+
+            static constexpr int mantissa_bits         = 52;
+            static constexpr int minimum_exponent      = -1023;
+            static constexpr int infinite_power        = 0x7FF;
+            static constexpr int min_round_to_even     = -4;
+            static constexpr int max_round_to_even     = 23;
+            static constexpr int max_fast_path_power   = 22;
+            static constexpr auto max_fast_path_mantissa = std::uint64_t{ 1 } << 53;
+        };
+
+        template <>
+        struct Format<float>
+        {
+            using Bits = std::uint32_t;
+
+            static constexpr int mantissa_bits         = 23;
+            static constexpr int minimum_exponent      = -127;
+            static constexpr int infinite_power        = 0xFF;
+            static constexpr int min_round_to_even     = -17;
+            static constexpr int max_round_to_even     = 10;
+            static constexpr int max_fast_path_power   = 10;
+            static constexpr auto max_fast_path_mantissa = std::uint64_t{ 1 } << 24;
+        };
+
+        /**
+         * @brief Compute `w * 10^q` correctly rounded using the Eisel-Lemire algorithm.
+         *
+         * @return The value or an empty optional if the result is not a normal number (zero, subnormal or
+         * infinity), these are left to `std::from_chars` so that the error reporting matches.
+         */
+        template <std::floating_point T>
+        constexpr Opt<T> compute(std::int64_t q, std::uint64_t w, bool negative) noexcept
+        {
+            using F = Format<T>;
+
+            if (w == 0 or q < smallest_power_of_five or q > largest_power_of_five) {
+                return {};
+            }
+
+            auto leading_zeros = std::countl_zero(w);
+            w <<= leading_zeros;
+
+            // product with the truncated power, refined with the low part only when the result may be affected
+            auto index     = static_cast<std::size_t>(q - smallest_power_of_five) * 2;
+            auto precision = std::uint64_t{ 0xFFFF'FFFF'FFFF'FFFF } >> (F::mantissa_bits + 3);
+            auto product   = mul(w, powers_of_five[index]);
+            if ((product.m_high & precision) == precision) {
+                auto second      = mul(w, powers_of_five[index + 1]);
+                product.m_low   += second.m_high;
+                if (second.m_high > product.m_low) {
+                    ++product.m_high;
+                }
+            }
+
+            auto upper_bit = static_cast<int>(product.m_high >> 63);
+            auto shift     = upper_bit + 64 - F::mantissa_bits - 3;
+            auto mantissa  = product.m_high >> shift;
+            auto power2    = static_cast<int>(((152'170 + 65'536) * q) >> 16) + 63 + upper_bit - leading_zeros
+                         - F::minimum_exponent;
+
+            if (power2 <= 0) {
+                return {};
+            }
+
+            // exactly halfway between two floats: round to even
+            if (product.m_low <= 1 and q >= F::min_round_to_even and q <= F::max_round_to_even
+                and (mantissa & 3) == 1 and (mantissa << shift) == product.m_high) {
+                mantissa &= ~std::uint64_t{ 1 };
+            }
+
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if (mantissa >= (std::uint64_t{ 2 } << F::mantissa_bits)) {
+                mantissa = std::uint64_t{ 1 } << F::mantissa_bits;
+                ++power2;
+            }
+            mantissa &= ~(std::uint64_t{ 1 } << F::mantissa_bits);
+
+            if (power2 >= F::infinite_power) {
+                return {};
+            }
+
+            auto bits = mantissa | (static_cast<std::uint64_t>(power2) << F::mantissa_bits);
+            if (negative) {
+                bits |= std::uint64_t{ 1 } << (sizeof(T) * 8 - 1);
+            }
+
+            return std::bit_cast<T>(static_cast<typename F::Bits>(bits));
+        }
+    }
+
+    /**
+     * @brief The powers of ten that are exact in a floating point type, used by Clinger's fast path.
+     */
+    template <std::floating_point T>
+    inline constexpr auto exact_powers_of_ten = [] {
+        auto powers = std::array<T, eisel_lemire::Format<T>::max_fast_path_power + 1>{};
+        auto power  = T{ 1 };
+        for (auto& p : powers) {
+            p      = power;
+            power *= 10;
+        }
+        return powers;
+    }();
+
+    /**
+     * @brief `std::from_chars` for the inputs the fast algorithms leave, which is not constexpr: they are
+     * rejected (`std::errc::not_supported`) in constant evaluation.
+     */
+    template <std::floating_point T>
+    constexpr std::from_chars_result from_chars_float(const char* first, const char* last, T& value) noexcept
+    {
+        if (std::is_constant_evaluated()) {
+            return { first, std::errc::not_supported };
+        }
+        return std::from_chars(first, last, value);
+    }
+
+    /**
+     * @brief Parse a floating point number in general format, has the same contract as `std::from_chars`.
+     *
+     * Decimals with up to 19 significant digits are converted using Clinger's fast path or the Eisel-Lemire
+     * algorithm, both are correctly rounded. The rest (more digits, subnormals, overflow, `inf`, `nan`, etc.)
+     * are handed to `std::from_chars`, so they can't be parsed in constant evaluation.
+     */
+    template <std::floating_point T>
+        requires std::same_as<T, float> or std::same_as<T, double>
+    constexpr std::from_chars_result parse_float(const char* first, const char* last, T& value) noexcept
+    {
+        using F = eisel_lemire::Format<T>;
+
+        auto* ptr       = first;
+        auto  negative  = false;
+        auto  mantissa  = std::uint64_t{ 0 };
+        auto  count     = std::size_t{ 0 };    // significant digits
+        auto  exponent  = std::int64_t{ 0 };
+
+        // accumulate a run of digits into the mantissa, 8 digits at a time if possible
+        const auto digits = [&] {
+            auto* begin = ptr;
+            while (last - ptr >= 8) {
+                auto chunk = swar::load(ptr, 8);
+                auto size  = swar::count_digits(chunk);
+                if (size == 0) {
+                    break;
+                }
+                if (count + size <= 19) {
+                    mantissa = mantissa * swar::pow10[size] + swar::parse_digits(chunk, size);
+                }
+                count += size;
+                ptr   += size;
+                if (size < 8) {
+                    return static_cast<std::size_t>(ptr - begin);
+                }
+            }
+            while (ptr != last and *ptr >= '0' and *ptr <= '9') {
+                if (count < 19) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*ptr - '0');
+                }
+                ++count;
+                ++ptr;
+            }
+            return static_cast<std::size_t>(ptr - begin);
+        };
+
+        const auto skip_zeros = [&] {
+            auto* begin = ptr;
+            while (ptr != last and *ptr == '0') {
+                ++ptr;
+            }
+            return static_cast<std::size_t>(ptr - begin);
+        };
+
+        if (ptr != last and *ptr == '-') {
+            negative = true;
+            ++ptr;
+        }
+
+        auto digit_count = skip_zeros() + digits();
+
+        if (ptr != last and *ptr == '.') {
+            ++ptr;
+            auto fraction = count == 0 ? skip_zeros() : 0;
+            fraction      += digits();
+            exponent      -= static_cast<std::int64_t>(fraction);
+            digit_count   += fraction;
+        }
+
+        // no digits: inf, nan or invalid
+        if (digit_count == 0 or count > 19) {
+            return from_chars_float(first, last, value);
+        }
+
+        if (ptr != last and (*ptr == 'e' or *ptr == 'E')) {
+            auto* exp_ptr      = ptr + 1;
+            auto  exp_negative = false;
+            if (exp_ptr != last and (*exp_ptr == '-' or *exp_ptr == '+')) {
+                exp_negative = *exp_ptr == '-';
+                ++exp_ptr;
+            }
+
+            // the exponent part is only consumed if it has digits
+            if (exp_ptr != last and *exp_ptr >= '0' and *exp_ptr <= '9') {
+                auto exp_value = std::int64_t{ 0 };
+                while (exp_ptr != last and *exp_ptr >= '0' and *exp_ptr <= '9') {
+                    if (exp_value < 0x10000) {
+                        exp_value = exp_value * 10 + (*exp_ptr - '0');
+                    }
+                    ++exp_ptr;
+                }
+                exponent += exp_negative ? -exp_value : exp_value;
+                ptr       = exp_ptr;
+            }
+        }
+
+        if (mantissa == 0) {
+            value = negative ? -T{ 0 } : T{ 0 };
+            return { ptr, std::errc{} };
+        }
+
+#if defined(FLT_EVAL_METHOD) and FLT_EVAL_METHOD == 0
+        // Clinger's fast path: both the mantissa and the power of ten are exact
+        if (mantissa <= F::max_fast_path_mantissa and exponent >= -F::max_fast_path_power
+            and exponent <= F::max_fast_path_power) {
+            const auto& exact = exact_powers_of_ten<T>;
+
+            auto result = static_cast<T>(mantissa);
+            if (exponent < 0) {
+                result /= exact[static_cast<std::size_t>(-exponent)];
+            } else {
+                result *= exact[static_cast<std::size_t>(exponent)];
+            }
+            value = negative ? -result : result;
+            return { ptr, std::errc{} };
+        }
+#endif
+
+        if (auto result = eisel_lemire::compute<T>(exponent, mantissa, negative)) {
+            value = *result;
+            return { ptr, std::errc{} };
+        }
+
+        return from_chars_float(first, last, value);
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_FLOAT_PARSER_HPP */
@@ -0,0 +1,297 @@
+#ifndef LINR_DETAIL_FORMAT_HPP
+#define LINR_DETAIL_FORMAT_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+
+namespace linr
+{
+    /**
+     * @brief Format string of a line, used as a template argument.
+     *
+     * eg: `linr::read<"ts={}, id:{}", long, std::string>()`
+     *
+     * Syntax:
+     * - `{}` is a value, two values must be separated by a literal.
+     * - `{{` and `}}` are literal braces.
+     * - A run of spaces matches any amount of whitespace (including none).
+     * - Other characters must match exactly.
+     *
+     * A value ends where the literal that follows it starts (or at whitespace if the literal starts with a
+     * space); the last value ends at the end of the line. Anything after the format is ignored.
+     */
+    template <std::size_t N>
+    struct FormatString
+    {
+        consteval FormatString(const char (&str)[N]) noexcept { std::copy_n(str, N, m_str); }
+
+        constexpr Str view() const noexcept { return { m_str, N - 1 }; }
+
+        char m_str[N];
+    };
+
+    namespace detail
+    {
+        enum class SegmentKind
+        {
+            Literal,
+            Space,
+            Value,
+        };
+
+        struct Segment
+        {
+            SegmentKind m_kind;
+            std::size_t m_offset = 0;    // literal only, range in the unescaped text
+            std::size_t m_size   = 0;
+        };
+
+        /**
+         * @brief Format string broken down into segments, computed at compile time.
+         */
+        template <std::size_t N>
+        struct CompiledFormat
+        {
+            std::array<Segment, N> m_segments = {};
+            std::array<char, N>    m_text     = {};
+            std::size_t            m_count    = 0;
+            std::size_t            m_values   = 0;
+        };
+
+        // not constexpr: calling this during compilation of a format is a compile error showing the message
+        inline void format_error(const char*) { }
+
+        template <std::size_t N>
+        consteval CompiledFormat<N> compile_format(FormatString<N> format)
+        {
+            auto str    = format.view();
+            auto result = CompiledFormat<N>{};
+            auto text   = std::size_t{ 0 };
+
+            const auto push = [&](SegmentKind kind) {
+                if (result.m_count > 0 and result.m_segments[result.m_count - 1].m_kind == kind) {
+                    if (kind == SegmentKind::Value) {
+                        format_error("two values must be separated by a literal");
+                    }
+                    return;    // extend the previous segment
+                }
+                result.m_segments[result.m_count++] = { kind, text, 0 };
+                result.m_values += kind == SegmentKind::Value ? 1 : 0;
+            };
+
+            const auto push_char = [&](char chr) {
+                push(SegmentKind::Literal);
+                result.m_text[text++] = chr;
+                ++result.m_segments[result.m_count - 1].m_size;
+            };
+
+            for (std::size_t i = 0; i < str.size(); ++i) {
+                if (str[i] == ' ') {
+                    push(SegmentKind::Space);
+                } else if (str.substr(i, 2) == "{}") {
+                    push(SegmentKind::Value);
+                    ++i;
+                } else if (str.substr(i, 2) == "{{" or str.substr(i, 2) == "}}") {
+                    push_char(str[i]);
+                    ++i;
+                } else if (str[i] == '{' or str[i] == '}') {
+                    format_error("unmatched brace, use '{{' or '}}' for literal braces");
+                } else {
+                    push_char(str[i]);
+                }
+            }
+
+            return result;
+        }
+
+        template <FormatString F>
+        inline constexpr auto compiled_format = compile_format(F);
+
+        /**
+         * @brief Where a value ends: at a character, at whitespace, or at the end of the line.
+         */
+        struct Terminator
+        {
+            char m_char  = '\0';    // '\0': none
+            bool m_space = false;
+        };
+
+        constexpr bool is_space(char chr) noexcept
+        {
+            return chr == ' ' or chr == '\t' or chr == '\r' or chr == '\v' or chr == '\f';
+        }
+
+        constexpr bool is_line_end(char chr) noexcept { return chr == '\0' or chr == '\n'; }
+
+        template <FormatString F, std::size_t S>
+        consteval Terminator terminator_of()
+        {
+            constexpr auto& format = compiled_format<F>;
+
+            auto result = Terminator{};
+            auto next   = S + 1;
+            if (next < format.m_count and format.m_segments[next].m_kind == SegmentKind::Space) {
+                result.m_space = true;
+                ++next;
+            }
+            // only a literal ends the value at its first character, a value segment has no text of its own
+            if (next < format.m_count and format.m_segments[next].m_kind == SegmentKind::Literal) {
+                result.m_char = format.m_text[format.m_segments[next].m_offset];
+            }
+            return result;
+        }
+
+        /**
+         * @brief Check whether a value ends at `pos`.
+         */
+        template <Terminator Term>
+        constexpr bool ends_at(Str line, std::size_t pos) noexcept
+        {
+            if (pos == line.size() or is_line_end(line[pos])) {
+                return true;
+            }
+            return (Term.m_char != '\0' and line[pos] == Term.m_char)    //
+                or (Term.m_space and is_space(line[pos]));
+        }
+
+        /**
+         * @brief Match segments of a format against a line from `S` onward, parsing values as they are found.
+         *
+         * @param line The line.
+         * @param pos Current position in the line.
+         * @param on_value Called as `on_value.template operator()<I, Term>(line, pos)` for each value,
+         * returns the position where the value ends or `Str::npos` on error.
+         * @return Whether the whole format is matched.
+         */
+        template <FormatString F, std::size_t S = 0, std::size_t I = 0, typename Fn>
+        bool match_format(Str line, std::size_t pos, Fn& on_value) noexcept
+        {
+            constexpr auto& format = compiled_format<F>;
+
+            if constexpr (S == format.m_count) {
+                return true;
+            } else {
+                constexpr auto segment = format.m_segments[S];
+
+                if constexpr (segment.m_kind == SegmentKind::Literal) {
+                    constexpr auto text = Str{ format.m_text.data() + segment.m_offset, segment.m_size };
+                    if (line.substr(pos, text.size()) != text) {
+                        return false;
+                    }
+                    return match_format<F, S + 1, I>(line, pos + text.size(), on_value);
+                } else if constexpr (segment.m_kind == SegmentKind::Space) {
+                    while (pos < line.size() and is_space(line[pos])) {
+                        ++pos;
+                    }
+                    return match_format<F, S + 1, I>(line, pos, on_value);
+                } else {
+                    pos = on_value.template operator()<I, terminator_of<F, S>()>(line, pos);
+                    if (pos == Str::npos) {
+                        return false;
+                    }
+                    return match_format<F, S + 1, I + 1>(line, pos, on_value);
+                }
+            }
+        }
+
+        /**
+         * @brief Find the end of a value that starts at `pos`.
+         */
+        template <Terminator Term>
+        std::size_t value_end(Str line, std::size_t pos) noexcept
+        {
+            while (not ends_at<Term>(line, pos)) {
+                ++pos;
+            }
+            return pos;
+        }
+
+        /**
+         * @brief Parse a line using a format.
+         *
+         * Default initializable values are parsed in place as they are found (numbers straight from the
+         * line), others are collected first and parsed with `parse_into_tuple`. A trailing CR is ignored (see
+         * `line_text`).
+         *
+         * @param line The line to be parsed.
+         */
+        template <FormatString F, Parseable... Ts>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> parse_format(Str line) noexcept
+        {
+            static_assert(
+                compiled_format<F>.m_values == sizeof...(Ts),
+                "the number of values in the format doesn't match the number of types"
+            );
+
+            line = line_text(line);
+
+            auto error = Error::InvalidInput;
+
+            if constexpr ((std::default_initializable<Ts> and ...)) {
+                auto values = Tup<Ts...>{};
+
+                auto on_value = [&]<std::size_t I, Terminator Term>(Str line, std::size_t pos) {
+                    using T = std::tuple_element_t<I, Tup<Ts...>>;
+
+                    auto& value = std::get<I>(values);
+
+                    if constexpr (PrefixParseable<T> and not is_number_char(Term.m_char)) {
+                        auto [ptr, ec] = DefaultParser<T>{}.parse_prefix(
+                            line.data() + pos, line.data() + line.size(), value
+                        );
+                        if (ec != std::errc{}) {
+                            error = ec == std::errc::result_out_of_range ? Error::OutOfRange : error;
+                            return Str::npos;
+                        }
+                        auto end = static_cast<std::size_t>(ptr - line.data());
+                        return ends_at<Term>(line, end) ? end : Str::npos;
+                    } else {
+                        auto end    = value_end<Term>(line, pos);
+                        auto result = parse<T>(line.substr(pos, end - pos));
+                        if (not result) {
+                            error = result.error();
+                            return Str::npos;
+                        }
+                        value = std::move(result).value();
+                        return end;
+                    }
+                };
+
+                if (match_format<F>(line, 0, on_value)) {
+                    return make_result<Tup<Ts...>>(std::move(values));
+                }
+            } else {
+                auto parts = std::array<Str, sizeof...(Ts)>{};
+
+                auto on_value = [&]<std::size_t I, Terminator Term>(Str line, std::size_t pos) {
+                    auto end = value_end<Term>(line, pos);
+                    parts[I] = line.substr(pos, end - pos);
+                    return end;
+                };
+
+                if (match_format<F>(line, 0, on_value)) {
+                    return parse_into_tuple<Ts...>(parts);
+                }
+            }
+
+            return make_error<Tup<Ts...>>(error);
+        }
+
+        template <FormatString F, Parseable... Ts, LineReader R>
+            requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+        Results<Ts...> read_format_impl(R& reader, Opt<Str> prompt) noexcept
+        {
+            const auto parse_fn = [](Str line) { return parse_format<F, Ts...>(line); };
+            return read_line_with<Tup<Ts...>>(reader, prompt, parse_fn);
+        }
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_FORMAT_HPP */
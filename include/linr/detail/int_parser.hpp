@@ -0,0 +1,211 @@
+#ifndef LINR_DETAIL_INT_PARSER_HPP
+#define LINR_DETAIL_INT_PARSER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace linr::detail
+{
+    namespace swar
+    {
+        inline constexpr auto pow10 = std::array<std::uint64_t, 9>{
+            1, 10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000,
+        };
+
+        /**
+         * @brief Load up to 8 bytes into an integer, the first byte in the lowest byte; missing bytes are zero.
+         */
+        constexpr std::uint64_t load(const char* ptr, std::size_t size) noexcept
+        {
+            const auto byte = [&](std::size_t i) {
+                return static_cast<std::uint64_t>(static_cast<unsigned char>(ptr[i])) << (8 * i);
+            };
+
+            if (std::is_constant_evaluated()) {
+                // no `memcpy` in constant evaluation, one byte at a time
+                auto chunk = std::uint64_t{ 0 };
+                for (std::size_t i = 0; i < std::min<std::size_t>(size, 8); ++i) {
+                    chunk |= byte(i);
+                }
+                return chunk;
+            } else if (size >= 8) {
+                auto chunk = std::uint64_t{ 0 };
+                std::memcpy(&chunk, ptr, 8);
+                return chunk;
+            } else if (size >= 4) {
+                // two overlapping 4 byte loads, the overlapping bytes are the same on both
+                auto low  = std::uint32_t{ 0 };
+                auto high = std::uint32_t{ 0 };
+                std::memcpy(&low, ptr, 4);
+                std::memcpy(&high, ptr + size - 4, 4);
+                return low | (static_cast<std::uint64_t>(high) << (8 * (size - 4)));
+            } else if (size > 0) {
+                return byte(0) | byte(size / 2) | byte(size - 1);
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Count the number of leading decimal digits in a chunk.
+         *
+         * @return A value in range [0, 8].
+         */
+        constexpr std::size_t count_digits(std::uint64_t chunk) noexcept
+        {
+            // a byte is a digit iff (byte ^ '0') < 10; the 0x7F mask prevents carry to the next byte
+            auto value    = chunk ^ 0x3030'3030'3030'3030;
+            auto nondigit = (((value & 0x7F7F'7F7F'7F7F'7F7F) + 0x7676'7676'7676'7676) | value)
+                          & 0x8080'8080'8080'8080;
+            return nondigit ? static_cast<std::size_t>(std::countr_zero(nondigit)) / 8 : 8;
+        }
+
+        /**
+         * @brief Convert the leading `count` digits of a chunk into their value.
+         *
+         * @param chunk The chunk, must contain at least `count` leading digits.
+         * @param count Number of digits in range [1, 8].
+         */
+        constexpr std::uint64_t parse_digits(std::uint64_t chunk, std::size_t count) noexcept
+        {
+            // shift the digits to the top so the bytes below act as leading zeros
+            auto value = (chunk ^ 0x3030'3030'3030'3030) << (8 * (8 - count));
+
+            value = value * 10 + (value >> 8);
+            value = (((value & 0x0000'00FF'0000'00FF) * (100 + (1'000'000ull << 32)))
+                     + (((value >> 16) & 0x0000'00FF'0000'00FF) * (1 + (10'000ull << 32))))
+                 >> 32;
+
+            return value;
+        }
+    }
+
+    /**
+     * @brief `std::from_chars` for decimal integers, which is not constexpr before C++23: parsed a digit at
+     * a time in constant evaluation.
+     */
+    template <std::integral T>
+    constexpr std::from_chars_result from_chars_int(const char* first, const char* last, T& value) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+
+        if (not std::is_constant_evaluated()) {
+            return std::from_chars(first, last, value);
+        }
+
+        auto* ptr      = first;
+        auto  negative = false;
+
+        if constexpr (std::is_signed_v<T>) {
+            if (ptr != last and *ptr == '-') {
+                negative = true;
+                ++ptr;
+            }
+        }
+
+        auto* digits    = ptr;
+        auto  magnitude = std::uint64_t{ 0 };
+        auto  overflow  = false;
+
+        while (ptr != last and *ptr >= '0' and *ptr <= '9') {
+            auto digit = static_cast<std::uint64_t>(*ptr - '0');
+            if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                overflow = true;
+            } else {
+                magnitude = magnitude * 10 + digit;
+            }
+            ++ptr;
+        }
+
+        if (ptr == digits) {
+            return { first, std::errc::invalid_argument };
+        }
+
+        auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        if (overflow or magnitude > limit) {
+            return { ptr, std::errc::result_out_of_range };
+        }
+
+        auto unsigned_value = static_cast<U>(magnitude);
+        value               = static_cast<T>(negative ? static_cast<U>(0 - unsigned_value) : unsigned_value);
+
+        return { ptr, std::errc{} };
+    }
+
+    /**
+     * @brief Parse a decimal integer 8 digits at a time (SWAR), has the same contract as `std::from_chars`.
+     *
+     * Inputs with more than 19 significant digits are handed to `std::from_chars`. Usable in constant
+     * evaluation.
+     */
+    template <std::integral T>
+    constexpr std::from_chars_result parse_int(const char* first, const char* last, T& value) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+
+        if constexpr (std::endian::native != std::endian::little) {
+            return from_chars_int(first, last, value);
+        }
+
+        auto* ptr      = first;
+        auto  negative = false;
+
+        if constexpr (std::is_signed_v<T>) {
+            if (ptr != last and *ptr == '-') {
+                negative = true;
+                ++ptr;
+            }
+        }
+
+        auto* digits = ptr;
+        while (ptr != last and *ptr == '0') {
+            ++ptr;
+        }
+
+        auto magnitude = std::uint64_t{ 0 };
+        auto count     = std::size_t{ 0 };    // significant digits
+
+        while (ptr != last) {
+            auto chunk = swar::load(ptr, static_cast<std::size_t>(last - ptr));
+            auto size  = swar::count_digits(chunk);    // the bytes past the end are zero (not digit)
+            if (size == 0) {
+                break;
+            }
+
+            if (count + size > 19) {
+                // may not fit in 64 bits
+                return from_chars_int(first, last, value);
+            }
+
+            magnitude  = magnitude * swar::pow10[size] + swar::parse_digits(chunk, size);
+            count     += size;
+            ptr       += size;
+
+            if (size < 8) {
+                break;
+            }
+        }
+
+        if (ptr == digits) {
+            return { first, std::errc::invalid_argument };
+        }
+
+        auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        if (magnitude > limit) {
+            return { ptr, std::errc::result_out_of_range };
+        }
+
+        auto unsigned_value = static_cast<U>(magnitude);
+        value               = static_cast<T>(negative ? static_cast<U>(0 - unsigned_value) : unsigned_value);
+
+        return { ptr, std::errc{} };
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_INT_PARSER_HPP */
@@ -0,0 +1,70 @@
+#ifndef LINR_DETAIL_LENDING_READER_HPP
+#define LINR_DETAIL_LENDING_READER_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+
+#include <concepts>
+#include <tuple>
+#include <utility>
+
+namespace linr::detail
+{
+    /**
+     * @brief Line reader that lends views into its line buffer, see `Borrowed`.
+     *
+     * Every line read invalidates the views lent so far (checked in debug builds only).
+     *
+     * @tparam R The underlying line reader.
+     */
+    template <LineReader R>
+    class LendingReader
+    {
+    public:
+        using Line = typename R::Line;
+
+        template <typename... Args>
+            requires std::constructible_from<R, Args...>
+        LendingReader(Args&&... args) noexcept
+            : m_reader(std::forward<Args>(args)...)
+        {
+        }
+
+        Opt<Line> readline() noexcept
+        {
+            m_epoch.advance();
+            return m_reader.readline();
+        }
+
+        /**
+         * @brief Attach the borrowed views of a parsed value (a tuple, a vector, an aggregate or a single
+         * value) to the current line.
+         */
+        template <typename T>
+        void lend([[maybe_unused]] T& value) const noexcept
+        {
+#ifndef NDEBUG
+            if constexpr (std::same_as<T, Borrowed>) {
+                m_epoch.lend(value);
+            } else if constexpr (IsVector<T>::value) {
+                for (auto& element : value) {
+                    lend(element);
+                }
+            } else if constexpr (requires { std::tuple_size<T>::value; }) {
+                std::apply([&](auto&... elements) { (lend(elements), ...); }, value);
+            } else if constexpr (Reflectable<T>) {
+                std::apply([&](auto&... members) { (lend(members), ...); }, tie_members(value));
+            }
+#endif
+        }
+
+    private:
+        R m_reader;
+
+        [[no_unique_address]] Epoch m_epoch;
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_LENDING_READER_HPP */
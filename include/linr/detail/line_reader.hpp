@@ -3,12 +3,23 @@
 
 #include "linr/common.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <cstdio>
+#include <cstring>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if defined(__unix__) or defined(__APPLE__)
+#    include <cerrno>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 namespace linr::detail
 {
     template <typename L>
@@ -166,6 +177,11 @@ namespace linr::detail
                 line.resize(line.size() * 2, '\0');
             }
 
+            // remove trailing newline
+            if (auto* newline = static_cast<char*>(std::memchr(line.data(), '\n', line.size()))) {
+                *newline = '\0';
+            }
+
             return Opt<Line>{ std::move(line) };
         }
     };
@@ -220,6 +236,11 @@ namespace linr::detail
                 m_buf.resize(m_buf.size() * 2, '\0');
             }
 
+            // remove trailing newline
+            if (auto* newline = static_cast<char*>(std::memchr(m_buf.data(), '\n', m_buf.size()))) {
+                *newline = '\0';
+            }
+
             return Opt<Line>{ std::in_place, m_buf.data(), m_buf.size() };
         }
 
@@ -227,6 +248,547 @@ namespace linr::detail
     };
     static_assert(LineReader<BufFgetsReader>);
 
+#if defined(__unix__) or defined(__APPLE__)
+    /**
+     * @brief Line reader that reads stdin in large blocks using `read(2)` directly, bypassing stdio.
+     *
+     * Lines are found using `memchr` and returned as views into the block buffer, so a line is only copied
+     * when it crosses a block boundary (the unconsumed tail is moved to the front before the next read). The
+     * buffer grows if a single line is longer than the buffer itself.
+     *
+     * Since this reader reads ahead of the current line, it must not be mixed with stdio-based reads of stdin.
+     */
+    struct BlockReader
+    {
+        struct Line
+        {
+            Line(char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        static constexpr std::size_t block_size = 256 * 1024;
+
+        BlockReader(std::size_t size = block_size)
+            : m_buf(std::max(size, block_size))
+        {
+        }
+
+        ~BlockReader() = default;
+
+        BlockReader(BlockReader&&)            = default;
+        BlockReader& operator=(BlockReader&&) = default;
+
+        BlockReader(const BlockReader&)            = delete;
+        BlockReader& operator=(const BlockReader&) = delete;
+
+        Opt<Line> readline() noexcept
+        {
+            while (true) {
+                auto* begin = m_buf.data() + m_begin;
+                auto* scan  = m_buf.data() + m_scanned;
+
+                if (auto* newline = static_cast<char*>(std::memchr(scan, '\n', m_end - m_scanned))) {
+                    auto size = static_cast<std::size_t>(newline - begin);
+                    m_begin   = m_begin + size + 1;
+                    m_scanned = m_begin;
+                    return Opt<Line>{ std::in_place, begin, size };
+                }
+                m_scanned = m_end;
+
+                if (m_eof) {
+                    if (m_begin == m_end) {
+                        return {};
+                    }
+
+                    // last line without trailing newline
+                    auto size = m_end - m_begin;
+                    m_begin   = m_end;
+                    return Opt<Line>{ std::in_place, begin, size };
+                }
+
+                fill();
+            }
+        }
+
+    private:
+        void fill() noexcept
+        {
+            // move the partial line to the front, this is the only place a line is copied
+            if (m_begin > 0) {
+                std::memmove(m_buf.data(), m_buf.data() + m_begin, m_end - m_begin);
+                m_end     -= m_begin;
+                m_scanned -= m_begin;
+                m_begin    = 0;
+            }
+
+            // a single line fills the whole buffer; double the size
+            if (m_end == m_buf.size()) {
+                m_buf.resize(m_buf.size() * 2);
+            }
+
+            // stdio no longer flushes stdout before reading stdin for us (prompt)
+            std::fflush(stdout);
+
+            auto nread = ::read(STDIN_FILENO, m_buf.data() + m_end, m_buf.size() - m_end);
+            while (nread == -1 and errno == EINTR) {
+                nread = ::read(STDIN_FILENO, m_buf.data() + m_end, m_buf.size() - m_end);
+            }
+
+            if (nread <= 0) {
+                m_eof = true;
+            } else {
+                m_end += static_cast<std::size_t>(nread);
+            }
+        }
+
+        std::vector<char> m_buf;
+        std::size_t       m_begin   = 0;    // start of unconsumed data
+        std::size_t       m_scanned = 0;    // data before this offset is known to have no newline
+        std::size_t       m_end     = 0;    // end of valid data
+        bool              m_eof     = false;
+    };
+    static_assert(LineReader<BlockReader>);
+
+    /**
+     * @brief Source of blocks of input for `BasicPrefetchReader`.
+     *
+     * `read` fills up to `size` bytes and returns how many were filled, 0 at EOF (or on error). The source is
+     * constructed, used and destroyed on the I/O thread.
+     */
+    template <typename S>
+    concept BlockSource = std::default_initializable<S> and requires (S s, char* out, std::size_t n) {
+        { s.read(out, n) } noexcept -> std::same_as<std::size_t>;
+    };
+
+    /**
+     * @brief Block source that reads stdin using `read(2)`.
+     */
+    struct StdinSource
+    {
+        std::size_t read(char* out, std::size_t size) noexcept
+        {
+            auto nread = ::read(STDIN_FILENO, out, size);
+            while (nread == -1 and errno == EINTR) {
+                nread = ::read(STDIN_FILENO, out, size);
+            }
+            return nread <= 0 ? 0 : static_cast<std::size_t>(nread);
+        }
+    };
+    static_assert(BlockSource<StdinSource>);
+
+    /**
+     * @brief Line reader that reads its input on a dedicated I/O thread, overlapping reads with parsing.
+     *
+     * The I/O thread fills a ring of buffers from the block source while the caller parses the lines of the
+     * buffer it holds; buffers are handed over using atomics (wait/notify), without locks. Lines are views
+     * into the buffer, a line is only copied when it crosses a buffer boundary. Useful when stdin is a pipe
+     * from a slow producer (decompressor, network tool), or when the source itself is slow to produce its
+     * blocks (see `DecompressSource`).
+     *
+     * Since this reader reads ahead of the current line, it must not be mixed with stdio-based reads of
+     * stdin. On destruction, it waits for the pending read of the I/O thread to return.
+     *
+     * @tparam Source The block source, see `BlockSource`.
+     */
+    template <BlockSource Source>
+    class BasicPrefetchReader
+    {
+    public:
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        static constexpr std::size_t block_size = 256 * 1024;
+
+        /**
+         * @param buffers Number of buffers in the ring (at least 2).
+         * @param size Size of each buffer.
+         */
+        BasicPrefetchReader(std::size_t buffers = 4, std::size_t size = block_size)
+            : m_ring{ std::make_unique<Ring>(std::max<std::size_t>(buffers, 2), std::max(size, block_size)) }
+            , m_thread{ &BasicPrefetchReader::produce, m_ring.get() }
+        {
+        }
+
+        ~BasicPrefetchReader() { stop(); }
+
+        BasicPrefetchReader(BasicPrefetchReader&& other) noexcept
+            : m_ring{ std::move(other.m_ring) }
+            , m_thread{ std::move(other.m_thread) }
+            , m_carry{ std::move(other.m_carry) }
+            , m_index{ other.m_index }
+            , m_pos{ other.m_pos }
+            , m_held{ other.m_held }
+            , m_eof{ other.m_eof }
+        {
+        }
+
+        BasicPrefetchReader& operator=(BasicPrefetchReader&& other) noexcept
+        {
+            if (this != &other) {
+                stop();
+                m_ring   = std::move(other.m_ring);
+                m_thread = std::move(other.m_thread);
+                m_carry  = std::move(other.m_carry);
+                m_index  = other.m_index;
+                m_pos    = other.m_pos;
+                m_held   = other.m_held;
+                m_eof    = other.m_eof;
+            }
+            return *this;
+        }
+
+        BasicPrefetchReader(const BasicPrefetchReader&)            = delete;
+        BasicPrefetchReader& operator=(const BasicPrefetchReader&) = delete;
+
+        Opt<Line> readline() noexcept
+        {
+            // the previous line is no longer needed
+            m_carry.clear();
+            auto carrying = false;
+
+            while (true) {
+                if (not m_held and (m_eof or not acquire())) {
+                    if (carrying) {
+                        // last line without trailing newline
+                        return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+                    }
+                    return {};
+                }
+
+                auto& buf   = m_ring->m_bufs[m_index];
+                auto* begin = static_cast<const char*>(buf.m_data.data() + m_pos);
+                auto  rest  = buf.m_size - m_pos;
+
+                if (auto* newline = static_cast<const char*>(std::memchr(begin, '\n', rest))) {
+                    auto size = static_cast<std::size_t>(newline - begin);
+                    m_pos     = m_pos + size + 1;
+
+                    if (not carrying) {
+                        return Opt<Line>{ std::in_place, begin, size };
+                    }
+                    m_carry.insert(m_carry.end(), begin, newline);
+                    return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+                }
+
+                // the line continues in the next buffer, this is the only place a line is copied
+                m_carry.insert(m_carry.end(), begin, begin + rest);
+                carrying = carrying or rest > 0;
+                release();
+            }
+        }
+
+    private:
+        enum State : std::uint32_t
+        {
+            Empty,
+            Full,
+            Eof,
+        };
+
+        struct Buffer
+        {
+            std::vector<char>          m_data;
+            std::size_t                m_size  = 0;
+            std::atomic<std::uint32_t> m_state = Empty;
+        };
+
+        struct Ring
+        {
+            Ring(std::size_t count, std::size_t size)
+                : m_bufs{ std::make_unique<Buffer[]>(count) }
+                , m_count{ count }
+            {
+                for (std::size_t i = 0; i < count; ++i) {
+                    m_bufs[i].m_data.resize(size);
+                }
+            }
+
+            std::unique_ptr<Buffer[]> m_bufs;
+            std::size_t               m_count;
+            std::atomic<bool>         m_stop = false;
+        };
+
+        // the I/O thread: fills the buffers in ring order, waiting for the caller to release them
+        static void produce(Ring* ring) noexcept
+        {
+            auto source = Source{};
+            for (std::size_t i = 0;; i = (i + 1) % ring->m_count) {
+                auto& buf = ring->m_bufs[i];
+                buf.m_state.wait(Full, std::memory_order_acquire);
+
+                if (ring->m_stop.load(std::memory_order_acquire)) {
+                    return;
+                }
+
+                buf.m_size = source.read(buf.m_data.data(), buf.m_data.size());
+
+                auto eof = buf.m_size == 0;
+                buf.m_state.store(eof ? Eof : Full, std::memory_order_release);
+                buf.m_state.notify_one();
+
+                if (eof) {
+                    return;
+                }
+            }
+        }
+
+        // wait for the I/O thread to fill the next buffer, returns false at EOF
+        bool acquire() noexcept
+        {
+            auto& buf = m_ring->m_bufs[m_index];
+
+            auto state = buf.m_state.load(std::memory_order_acquire);
+            if (state == Empty) {
+                // stdio no longer flushes stdout before reading stdin for us (prompt)
+                std::fflush(stdout);
+                buf.m_state.wait(Empty, std::memory_order_acquire);
+                state = buf.m_state.load(std::memory_order_acquire);
+            }
+
+            if (state == Eof) {
+                m_eof = true;
+                return false;
+            }
+
+            m_held = true;
+            m_pos  = 0;
+            return true;
+        }
+
+        // hand the current buffer back to the I/O thread
+        void release() noexcept
+        {
+            auto& buf = m_ring->m_bufs[m_index];
+            buf.m_state.store(Empty, std::memory_order_release);
+            buf.m_state.notify_one();
+
+            m_index = (m_index + 1) % m_ring->m_count;
+            m_held  = false;
+        }
+
+        void stop() noexcept
+        {
+            if (not m_ring) {
+                return;
+            }
+
+            // wake the I/O thread up if it waits for a buffer
+            m_ring->m_stop.store(true, std::memory_order_release);
+            for (std::size_t i = 0; i < m_ring->m_count; ++i) {
+                m_ring->m_bufs[i].m_state.store(Empty, std::memory_order_release);
+                m_ring->m_bufs[i].m_state.notify_one();
+            }
+
+            m_thread.join();
+            m_ring.reset();
+        }
+
+        std::unique_ptr<Ring> m_ring;
+        std::thread           m_thread;
+        std::vector<char>     m_carry;
+        std::size_t           m_index = 0;        // buffer being read
+        std::size_t           m_pos   = 0;        // start of unconsumed data in the buffer
+        bool                  m_held  = false;    // the buffer is filled and owned by the caller
+        bool                  m_eof   = false;
+    };
+
+    using PrefetchReader = BasicPrefetchReader<StdinSource>;
+    static_assert(LineReader<PrefetchReader>);
+
+    /**
+     * @brief Read-only memory mapping of stdin, only possible if stdin is a regular file.
+     *
+     * The mapping starts at the current position of stdin, which accounts for the input stdio has already
+     * buffered (eg: a line read before with `linr::read`). On destruction, the position of stdin is set to
+     * the end of the consumed part (see `consume`) so that subsequent reads continue from there.
+     */
+    class StdinMapping
+    {
+    public:
+        /**
+         * @brief Map stdin into memory.
+         *
+         * @param huge_pages Advise the kernel to back the mapping with transparent huge pages (a hint).
+         * @return The mapping or an empty optional if stdin is not a regular file or the mapping failed.
+         */
+        static Opt<StdinMapping> map(bool huge_pages = false) noexcept
+        {
+            struct stat info = {};
+            if (::fstat(STDIN_FILENO, &info) != 0 or not S_ISREG(info.st_mode)) {
+                return {};
+            }
+
+            // the logical position, not the offset of the descriptor which is past the stdio buffer
+            auto offset = std::ftell(stdin);
+            if (offset == -1 or offset > info.st_size) {
+                return {};
+            }
+
+            auto mapping = StdinMapping{};
+            mapping.m_size   = static_cast<std::size_t>(info.st_size);
+            mapping.m_offset = static_cast<std::size_t>(offset);
+            mapping.m_pos    = mapping.m_offset;
+
+            // mmap can't map an empty file
+            if (mapping.m_size == 0) {
+                return mapping;
+            }
+
+            auto* addr = ::mmap(nullptr, mapping.m_size, PROT_READ, MAP_PRIVATE, STDIN_FILENO, 0);
+            if (addr == MAP_FAILED) {
+                return {};
+            }
+            mapping.m_data = static_cast<const char*>(addr);
+
+            ::madvise(addr, mapping.m_size, MADV_SEQUENTIAL);
+#    if defined(MADV_HUGEPAGE)
+            if (huge_pages) {
+                ::madvise(addr, mapping.m_size, MADV_HUGEPAGE);
+            }
+#    else
+            (void)huge_pages;
+#    endif
+
+            return mapping;
+        }
+
+        ~StdinMapping() { release(); }
+
+        StdinMapping(StdinMapping&& other) noexcept
+            : m_data{ std::exchange(other.m_data, nullptr) }
+            , m_size{ std::exchange(other.m_size, 0) }
+            , m_offset{ std::exchange(other.m_offset, 0) }
+            , m_pos{ std::exchange(other.m_pos, 0) }
+        {
+        }
+
+        StdinMapping& operator=(StdinMapping&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                m_data   = std::exchange(other.m_data, nullptr);
+                m_size   = std::exchange(other.m_size, 0);
+                m_offset = std::exchange(other.m_offset, 0);
+                m_pos    = std::exchange(other.m_pos, 0);
+            }
+            return *this;
+        }
+
+        StdinMapping(const StdinMapping&)            = delete;
+        StdinMapping& operator=(const StdinMapping&) = delete;
+
+        /**
+         * @brief The unconsumed part of the mapping.
+         */
+        Str remaining() const noexcept { return m_data ? Str{ m_data + m_pos, m_size - m_pos } : Str{}; }
+
+        /**
+         * @brief Mark `count` bytes of the remaining part as consumed.
+         */
+        void consume(std::size_t count) noexcept { m_pos += count; }
+
+    private:
+        StdinMapping() = default;
+
+        // unmap, and move stdin past the consumed part
+        void release() noexcept
+        {
+            if (m_data) {
+                ::munmap(const_cast<char*>(m_data), m_size);
+            }
+            if (m_pos != m_offset) {
+                // drops the stale stdio buffer too
+                std::fseek(stdin, static_cast<long>(m_pos), SEEK_SET);
+            }
+        }
+
+        const char* m_data   = nullptr;
+        std::size_t m_size   = 0;
+        std::size_t m_offset = 0;
+        std::size_t m_pos    = 0;
+    };
+
+    /**
+     * @brief Line reader that maps stdin into memory if it is a regular file (eg: `./app < data.txt`).
+     *
+     * Lines are plain views into the mapping, there is no read, copy or buffer growth. If stdin can't be
+     * mapped (pipe, terminal, etc.), it falls back to `BlockReader`.
+     *
+     * The mapping starts where the previous reads stopped, but since this reader reads ahead of the current
+     * line (and its fallback too), it must not be mixed with stdio-based reads of stdin while it is in use.
+     */
+    struct MappedReader
+    {
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        /**
+         * @param huge_pages Advise the kernel to use transparent huge pages for the mapping.
+         */
+        MappedReader(bool huge_pages = false)
+            : m_mapping{ StdinMapping::map(huge_pages) }
+        {
+            if (not m_mapping) {
+                m_fallback.emplace();
+            }
+        }
+
+        /**
+         * @brief Check whether stdin is actually mapped into memory.
+         */
+        bool is_mapped() const noexcept { return m_mapping.has_value(); }
+
+        Opt<Line> readline() noexcept
+        {
+            if (m_fallback) {
+                auto line = m_fallback->readline();
+                if (not line) {
+                    return {};
+                }
+                auto str = line->view();
+                return Opt<Line>{ std::in_place, str.data(), str.size() };
+            }
+
+            auto rest = m_mapping->remaining();
+            if (rest.empty()) {
+                return {};
+            }
+
+            auto* newline = static_cast<const char*>(std::memchr(rest.data(), '\n', rest.size()));
+            if (newline == nullptr) {
+                m_mapping->consume(rest.size());
+                return Opt<Line>{ std::in_place, rest.data(), rest.size() };
+            }
+
+            auto size = static_cast<std::size_t>(newline - rest.data());
+            m_mapping->consume(size + 1);
+            return Opt<Line>{ std::in_place, rest.data(), size };
+        }
+
+        Opt<StdinMapping> m_mapping;
+        Opt<BlockReader>  m_fallback;
+    };
+    static_assert(LineReader<MappedReader>);
+#endif
+
 #if defined(__GLIBC__) and defined(LINR_ENABLE_GETLINE)
     using Reader    = GetlineReader;
     using BufReader = BufGetlineReader;
@@ -0,0 +1,77 @@
+#ifndef LINR_DETAIL_MEMORY_HPP
+#define LINR_DETAIL_MEMORY_HPP
+
+#include "linr/common.hpp"
+
+#include <concepts>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace linr::detail
+{
+    inline thread_local std::pmr::memory_resource* t_resource = nullptr;
+
+    /**
+     * @brief The memory resource used by the parsers of allocator-aware types (eg: `std::pmr::string`) on
+     * this thread, see `ScopedResource`.
+     */
+    inline std::pmr::memory_resource* current_resource() noexcept
+    {
+        return t_resource ? t_resource : std::pmr::get_default_resource();
+    }
+
+    /**
+     * @brief Sets the memory resource of the parsers on this thread for the lifetime of the object.
+     *
+     * Parsers are stateless, so the resource of a read is passed to them this way instead of through every
+     * layer of the read.
+     */
+    class ScopedResource
+    {
+    public:
+        explicit ScopedResource(std::pmr::memory_resource* resource) noexcept
+            : m_previous{ std::exchange(t_resource, resource) }
+        {
+        }
+
+        ScopedResource(const ScopedResource&)            = delete;
+        ScopedResource& operator=(const ScopedResource&) = delete;
+
+        ~ScopedResource() { t_resource = m_previous; }
+
+    private:
+        std::pmr::memory_resource* m_previous;
+    };
+
+    /**
+     * @brief The memory resource of a vector if it uses a polymorphic allocator, otherwise the current one.
+     */
+    template <typename T, typename A>
+    std::pmr::memory_resource* resource_of(const std::vector<T, A>& values) noexcept
+    {
+        if constexpr (std::same_as<A, std::pmr::polymorphic_allocator<T>>) {
+            return values.get_allocator().resource();
+        } else {
+            return current_resource();
+        }
+    }
+
+    /**
+     * @brief Default construct the values of a line, allocator-aware ones use the current memory resource so
+     * the parsed values can be moved into them without a copy.
+     */
+    template <typename... Ts>
+    Tup<Ts...> make_values() noexcept
+    {
+        if constexpr ((std::uses_allocator_v<Ts, std::pmr::polymorphic_allocator<>> or ...)) {
+            auto alloc = std::pmr::polymorphic_allocator<>{ current_resource() };
+            return std::make_obj_using_allocator<Tup<Ts...>>(alloc);
+        } else {
+            return Tup<Ts...>{};
+        }
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_MEMORY_HPP */
@@ -0,0 +1,110 @@
+#ifndef LINR_DETAIL_MPMC_QUEUE_HPP
+#define LINR_DETAIL_MPMC_QUEUE_HPP
+
+#include "linr/common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace linr::detail
+{
+    /**
+     * @brief Bounded lock-free multi-producer multi-consumer queue (Dmitry Vyukov's algorithm).
+     *
+     * Each cell has a sequence number telling whether it is ready to be written or read for the current lap,
+     * so producers and consumers only contend on their own index. Operations never block, they fail when the
+     * queue is full or empty.
+     *
+     * @tparam T The element type.
+     */
+    template <typename T>
+        requires std::default_initializable<T> and std::movable<T>
+    class MpmcQueue
+    {
+    public:
+        /**
+         * @param capacity The capacity, rounded up to a power of two.
+         */
+        explicit MpmcQueue(std::size_t capacity)
+            : m_mask{ std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1 }
+            , m_cells{ std::make_unique<Cell[]>(m_mask + 1) }
+        {
+            for (std::size_t i = 0; i <= m_mask; ++i) {
+                m_cells[i].m_seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Push a value, fails (and the value is untouched) if the queue is full.
+         */
+        bool try_push(T& value) noexcept
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            while (true) {
+                auto& cell = m_cells[pos & m_mask];
+                auto  seq  = cell.m_seq.load(std::memory_order_acquire);
+                auto  diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.m_value = std::move(value);
+                        cell.m_seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;    // full
+                } else {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Pop a value, fails if the queue is empty.
+         */
+        Opt<T> try_pop() noexcept
+        {
+            auto pos = m_head.load(std::memory_order_relaxed);
+            while (true) {
+                auto& cell = m_cells[pos & m_mask];
+                auto  seq  = cell.m_seq.load(std::memory_order_acquire);
+                auto  diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+                if (diff == 0) {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        auto value = std::move(cell.m_value);
+                        cell.m_seq.store(pos + m_mask + 1, std::memory_order_release);
+                        return value;
+                    }
+                } else if (diff < 0) {
+                    return std::nullopt;    // empty
+                } else {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        static constexpr std::size_t cache_line = 64;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> m_seq;
+            T                        m_value;
+        };
+
+        const std::size_t       m_mask;
+        std::unique_ptr<Cell[]> m_cells;
+
+        // producers and consumers don't share a cache line
+        alignas(cache_line) std::atomic<std::size_t> m_tail = 0;
+        alignas(cache_line) std::atomic<std::size_t> m_head = 0;
+    };
+}
+
+#endif /* end of include guard: LINR_DETAIL_MPMC_QUEUE_HPP */
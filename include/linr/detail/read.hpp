@@ -2,18 +2,401 @@
 #define LINR_DETAIL_READ_HPP
 
 #include "linr/common.hpp"
+#include "linr/detail/aggregate.hpp"
 #include "linr/detail/line_reader.hpp"
+#include "linr/detail/memory.hpp"
+#include "linr/detail/scanner.hpp"
 #include "linr/parser.hpp"
+#include "linr/skip.hpp"
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace linr::detail
 {
-    template <Parseable... Ts, LineReader R>
+    /**
+     * @brief Types whose default parser can parse a number at the start of a string (see `parse_prefix`).
+     */
+    template <typename T>
+    concept PrefixParseable = not CustomParseable<T>
+                          and requires (const DefaultParser<T> p, const char* ptr, T& value) {
+                                  { p.parse_prefix(ptr, ptr, value) } noexcept;
+                              };
+
+    template <typename>
+    struct IsVector : std::false_type
+    {
+    };
+
+    template <typename T, typename A>
+    struct IsVector<std::vector<T, A>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief A `std::vector` of parseable values that has no parser of its own (read one value per field).
+     */
+    template <typename V>
+    concept ParseableVector = IsVector<V>::value and Parseable<typename V::value_type> and not Parseable<V>;
+
+    /**
+     * @brief A `std::vector` that allocates from a memory resource (`std::pmr::vector`).
+     */
+    template <typename V>
+    concept PmrVector = IsVector<V>::value
+                    and std::same_as<
+                            typename V::allocator_type,
+                            std::pmr::polymorphic_allocator<typename V::value_type>>;
+
+    /**
+     * @brief Check whether a character may appear in a number accepted by `std::from_chars`.
+     */
+    constexpr bool is_number_char(char chr) noexcept
+    {
+        auto lower = static_cast<char>(chr | 0x20);
+        return (chr >= '0' and chr <= '9') or (lower >= 'a' and lower <= 'z')
+            or Str{ "+-._()" }.find(chr) != Str::npos;
+    }
+
+    /**
+     * @brief Characters that may appear in a number accepted by `std::from_chars` (see `is_number_char`).
+     */
+    inline constexpr auto number_chars = Delim::any_of(
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+-._()"
+    );
+
+    /**
+     * @brief Check whether numbers can be parsed straight from a line split by a delimiter, which is the case
+     * if the delimiter can't be part of a number.
+     */
+    constexpr bool can_parse_prefix(const Delim& delim) noexcept
+    {
+        if (delim.kind() == Delim::Kind::Set) {
+            return not delim.intersects(number_chars);
+        }
+        return not is_number_char(delim.first());
+    }
+
+    /**
+     * @brief Parse the field under a cursor into a value.
+     *
+     * @tparam Prefix Parse numbers straight from the rest of the line (see `can_parse_prefix`).
+     * @param cursor The cursor, positioned at the start of the field (see `FieldCursor::seek`).
+     * @param value The parsed value.
+     * @return The error if the field fails to be parsed.
+     */
+    template <bool Prefix, Parseable T, typename S>
+    Opt<Error> parse_field(FieldCursor<S>& cursor, T& value) noexcept
+    {
+        if constexpr (Prefix and PrefixParseable<T>) {
+            auto rest      = cursor.rest();
+            auto end       = rest.data() + rest.size();
+            auto [ptr, ec] = DefaultParser<T>{}.parse_prefix(rest.data(), end, value);
+
+            if (ec == std::errc::result_out_of_range) {
+                return Error::OutOfRange;
+            } else if (ec != std::errc{} or not cursor.take(static_cast<std::size_t>(ptr - rest.data()))) {
+                return Error::InvalidInput;
+            }
+        } else {
+            auto result = parse<T>(cursor.take());
+            if (not result) {
+                return result.error();
+            }
+            value = std::move(result).value();
+        }
+        return std::nullopt;
+    }
+
+}
+
+namespace linr
+{
+    /**
+     * @brief Tokens of a line, handed to the custom parsers that take a cursor (see `CursorParseable`).
+     *
+     * The parser pulls the tokens it needs from the scan of the line the other values are parsed from, and
+     * the values after it are parsed from where it stops. Nested values are parsed with `parse`, so parsers
+     * compose.
+     */
+    class Cursor
+    {
+    public:
+        /**
+         * @param fields The fields of the line.
+         * @param prefix Parse numbers straight from the line (see `detail::can_parse_prefix`).
+         */
+        Cursor(detail::FieldCursor<detail::Scanner>& fields, bool prefix) noexcept
+            : m_fields{ fields }
+            , m_prefix{ prefix }
+        {
+        }
+
+        /**
+         * @brief Take the next token.
+         *
+         * @return The token, or nothing at the end of the line.
+         */
+        Opt<Str> next() noexcept
+        {
+            if (not seek()) {
+                return std::nullopt;
+            }
+            return m_fields.take();
+        }
+
+        /**
+         * @brief Parse the next value, which takes as many tokens as its type needs.
+         */
+        template <detail::Readable T>
+            requires std::movable<T>
+        Result<T> parse() noexcept
+        {
+            if constexpr (CursorParseable<T>) {
+                return CustomParser<T>{}.parse(*this);
+            } else if constexpr (std::default_initializable<T>) {
+                auto value = T{};
+                if (auto error = parse_into(value)) {
+                    return make_error<T>(*error);
+                }
+                return make_result<T>(std::move(value));
+            } else {
+                auto token = next();
+                if (not token) {
+                    return make_error<T>(Error::InvalidInput);
+                }
+                return linr::parse<T>(*token);
+            }
+        }
+
+        /**
+         * @brief Parse the next value in place, see `parse`.
+         *
+         * @return The error if the value fails to be parsed.
+         */
+        template <detail::Readable T>
+            requires std::movable<T>
+        Opt<Error> parse_into(T& value) noexcept
+        {
+            if constexpr (CursorParseable<T>) {
+                auto result = CustomParser<T>{}.parse(*this);
+                if (not result) {
+                    return result.error();
+                }
+                value = std::move(result).value();
+            } else if constexpr (detail::Reflectable<T>) {
+                auto error = Opt<Error>{};
+                std::apply(
+                    [&](auto&... members) { ((error = parse_into(members), not error) and ...); },
+                    detail::tie_members(value)
+                );
+                return error;
+            } else if (not seek()) {
+                return Error::InvalidInput;
+            } else {
+                return m_prefix ? detail::parse_field<true>(m_fields, value)
+                                : detail::parse_field<false>(m_fields, value);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief The rest of the line, from the current position (the delimiters before the next token
+         * included).
+         */
+        Str rest() const noexcept
+        {
+            auto rest = m_fields.rest();
+            return rest.substr(0, rest.find_first_of(Str{ "\0\n", 2 }));
+        }
+
+        /**
+         * @brief Check whether every token of the line is taken.
+         */
+        bool empty() noexcept { return not seek(); }
+
+    private:
+        // move to the next token, delimiters at the end of the line are ignored
+        bool seek() noexcept
+        {
+            if (not m_fields.seek()) {
+                return false;
+            }
+            auto rest = m_fields.rest();
+            return not (rest.empty() or rest[0] == '\0' or rest[0] == '\n');
+        }
+
+        detail::FieldCursor<detail::Scanner>& m_fields;
+        bool                                  m_prefix;
+    };
+}
+
+namespace linr::detail
+{
+    /**
+     * @brief A value parsed from a field, an aggregate or a cursor parsed type parsed from consecutive fields
+     * (see `Reflectable` and `CursorParseable`), or skipped fields (see `Ignore`).
+     */
+    template <typename T>
+    concept Projectable = Readable<T> or Skipped<T>;
+
+    /**
+     * @brief Parse the fields of a line into a tuple in a single pass.
+     *
+     * The fields are parsed as they are found and parsing stops at the first error. Numbers are parsed
+     * straight from the line and the field boundary is checked where the number ends, so the line is scanned
+     * once. The members of an aggregate are parsed in place from consecutive fields, and the cursor parsed
+     * types take their tokens from the same scan (see `Cursor`). Skipped fields are only
+     * scanned for their end, and the fields after the last type are not scanned at all.
+     *
+     * @param line The line to be parsed.
+     * @param delim Delimiter between values.
+     */
+    template <Projectable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::default_initializable<Ts> and ...)
+             and (std::movable<Ts> and ...)
+    Result<Projected<Ts...>> parse_fields(Str line, const Delim& delim) noexcept
+    {
+        using Values = Projected<Ts...>;
+
+        auto cursor = FieldCursor{ Scanner{ line, delim } };
+        auto values = []<typename... Us>(std::type_identity<Tup<Us...>>) {
+            return make_values<Us...>();
+        }(std::type_identity<Values>{});
+        auto error = Error::InvalidInput;
+
+        const auto parse_next = [&]<bool Prefix, std::size_t K>() {
+            using T = std::tuple_element_t<K, Tup<Ts...>>;
+
+            if constexpr (Skipped<T>) {
+                for (std::size_t i = 0; i < FieldWidth<T>::value; ++i) {
+                    if (not cursor.seek()) {
+                        return false;
+                    }
+                    cursor.take();
+                }
+                return true;
+            } else {
+                const auto parse_value = [&]<typename V>(V& value) {
+                    auto result = Opt<Error>{};
+                    if constexpr (CursorParseable<V>) {
+                        // the parser takes its tokens from the same scan
+                        result = Cursor{ cursor, Prefix }.parse_into(value);
+                    } else if (not cursor.seek()) {
+                        return false;
+                    } else {
+                        result = parse_field<Prefix>(cursor, value);
+                    }
+
+                    if (result) {
+                        error = *result;
+                        return false;
+                    }
+                    return true;
+                };
+
+                auto& value = std::get<projected_index<K, Ts...>>(values);
+                if constexpr (Reflectable<T>) {
+                    return std::apply([&](auto&... members) { return (parse_value(members) and ...); },
+                                      tie_members(value));
+                } else {
+                    return parse_value(value);
+                }
+            }
+        };
+
+        // short-circuit: stops at the first field that fails
+        const auto parse_all = [&]<bool Prefix>() {
+            return [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+                return (parse_next.template operator()<Prefix, Ks>() and ...);
+            }(std::index_sequence_for<Ts...>{});
+        };
+
+        // a delimiter that can be part of a number must be found before the number is parsed
+        auto prefix = can_parse_prefix(delim);
+
+        if (prefix ? parse_all.template operator()<true>() : parse_all.template operator()<false>()) {
+            return make_result<Values>(std::move(values));
+        }
+        return make_error<Values>(error);
+    }
+
+    /**
+     * @brief The text of a line without its line ending.
+     *
+     * The line readers may leave the newline (or NULs) at the end of the line, and a CR before it is removed
+     * too so that CRLF input parses like LF input.
+     */
+    constexpr Str line_text(Str line) noexcept
+    {
+        while (not line.empty() and (line.back() == '\0' or line.back() == '\n')) {
+            line.remove_suffix(1);
+        }
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    /**
+     * @brief Split a line and parse the parts into a tuple.
+     *
+     * Default initializable types are parsed in a single pass (see `parse_fields`), others are split first.
+     * A trailing CR is ignored (see `line_text`).
+     *
+     * @param line The line to be parsed.
+     * @param delim Delimiter between values.
+     */
+    template <Projectable... Ts>
         requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
-    Results<Ts...> read_impl(R& reader, Opt<Str> prompt, char delim) noexcept
+    Result<Projected<Ts...>> parse_line(Str line, const Delim& delim) noexcept
+    {
+        using Values = Projected<Ts...>;
+
+        line = line_text(line);
+
+        if constexpr ((std::default_initializable<Ts> and ...)) {
+            return parse_fields<Ts...>(line, delim);
+        } else {
+            static_assert(not ((Reflectable<Ts> or CursorParseable<Ts>) or ...),
+                          "aggregates and cursor parsed types can't be read along with types that are not "
+                          "default initializable");
+
+            auto parts = util::split<field_count<Ts...>>(line, delim);
+            if (not parts) {
+                return make_error<Values>(Error::InvalidInput);
+            }
+
+            // only the parts of the types that are not skipped are parsed
+            return [&]<typename... Us>(std::type_identity<Tup<Us...>>) {
+                constexpr auto fields = kept_fields<Ts...>;
+
+                auto kept = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                    return std::array<Str, sizeof...(Us)>{ (*parts)[fields[Is]]... };
+                }(std::index_sequence_for<Us...>{});
+                return parse_into_tuple<Us...>(kept);
+            }(std::type_identity<Values>{});
+        }
+    }
+
+    /**
+     * @brief Read a line from a line reader and parse it.
+     *
+     * @param reader The line reader.
+     * @param prompt The prompt.
+     * @param parse_fn Parses the line, called as `parse_fn(Str) -> Result<T>`.
+     */
+    template <typename T, LineReader R, typename Fn>
+    Result<T> read_line_with(R& reader, Opt<Str> prompt, Fn&& parse_fn) noexcept
     {
         // first and foremost, check whether stdin available at all
         if (std::ferror(stdin)) {
-            return make_error<Tup<Ts...>>(Error::Unknown);
+            return make_error<T>(Error::Unknown);
         }
 
         if (prompt) {
@@ -22,14 +405,166 @@ namespace linr::detail
 
         auto line = reader.readline();
         if (not line) {
-            return make_error<Tup<Ts...>>(Error::EndOfFile);
+            return make_error<T>(Error::EndOfFile);
+        }
+
+        return parse_fn(line->view());
+    }
+
+    template <Projectable... Ts, LineReader R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Result<Projected<Ts...>> read_impl(R& reader, Opt<Str> prompt, const Delim& delim) noexcept
+    {
+        const auto parse_fn = [&](Str line) { return parse_line<Ts...>(line, delim); };
+        return read_line_with<Projected<Ts...>>(reader, prompt, parse_fn);
+    }
+
+    /**
+     * @brief Parse every field of a line into a vector.
+     *
+     * Delimiters (and a CR) at the end of the line are ignored. On error, the values parsed before the
+     * failing field are kept in the vector.
+     *
+     * @param line The line to be parsed.
+     * @param delim Delimiter between values.
+     * @param values The vector, cleared before parsing (its capacity is reused). Allocator-aware values are
+     * allocated from the memory resource of the vector if it has a polymorphic allocator.
+     * @return Number of values or the error of the first field that fails.
+     */
+    template <Parseable T, typename A>
+        requires std::movable<T>
+    Result<std::size_t> parse_values(Str line, const Delim& delim, std::vector<T, A>& values) noexcept
+    {
+        values.clear();
+
+        auto scope  = ScopedResource{ resource_of(values) };
+        auto cursor = FieldCursor{ Scanner{ line_text(line), delim } };
+
+        const auto parse_all = [&]<bool Prefix>() -> Opt<Error> {
+            while (cursor.seek()) {
+                if (auto rest = cursor.rest(); rest.empty() or rest[0] == '\0' or rest[0] == '\n') {
+                    break;    // trailing delimiters
+                }
+
+                if constexpr (std::default_initializable<T>) {
+                    // parse in place
+                    if (auto error = parse_field<Prefix>(cursor, values.emplace_back())) {
+                        values.pop_back();
+                        return error;
+                    }
+                } else {
+                    auto result = parse<T>(cursor.take());
+                    if (not result) {
+                        return result.error();
+                    }
+                    values.push_back(std::move(result).value());
+                }
+            }
+            return std::nullopt;
+        };
+
+        auto error = can_parse_prefix(delim) ? parse_all.template operator()<true>()
+                                             : parse_all.template operator()<false>();
+        if (error) {
+            return make_error<std::size_t>(*error);
+        }
+        return make_result<std::size_t>(values.size());
+    }
+
+    template <Parseable T, typename A, LineReader R>
+        requires std::movable<T>
+    Result<std::size_t> read_into_impl(
+        R&                 reader,
+        Opt<Str>           prompt,
+        const Delim&       delim,
+        std::vector<T, A>& values
+    ) noexcept
+    {
+        const auto parse_fn = [&](Str line) { return parse_values(line, delim, values); };
+        return read_line_with<std::size_t>(reader, prompt, parse_fn);
+    }
+
+    /**
+     * @brief Read lines until EOF, parsing each value straight into its column.
+     *
+     * The fields are parsed in a single pass like `parse_fields`, default initializable values are parsed in
+     * place at the end of their column. Empty lines are skipped (a trailing CR is removed first, see
+     * `line_text`), like `parse_all` does. On parse error, the partially parsed row is removed so all columns
+     * keep the same size (the columns are expected to have the same size at the start).
+     *
+     * @param reader The line reader.
+     * @param columns The columns the values are appended into.
+     * @param delim Delimiter between values.
+     * @return Number of rows appended or the error that stops the read.
+     */
+    template <Parseable... Ts, LineReader R>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+    Result<std::size_t> read_columns_impl(
+        R&                       reader,
+        Tup<std::vector<Ts>...>& columns,
+        const Delim&             delim
+    ) noexcept
+    {
+        using Seq = std::index_sequence_for<Ts...>;
+
+        if (std::ferror(stdin)) {
+            return make_error<std::size_t>(Error::Unknown);
         }
 
-        auto parts = util::split<sizeof...(Ts)>(line->view(), delim);
-        if (parts) {
-            return parse_into_tuple<Ts...>(*parts);
+        auto rows  = std::size_t{ 0 };
+        auto error = Opt<Error>{};
+
+        const auto push = [&]<bool Prefix, typename T>(auto& cursor, std::vector<T>& column) {
+            if (not cursor.seek()) {
+                error = Error::InvalidInput;
+                return false;
+            }
+
+            if constexpr (std::default_initializable<T>) {
+                // parse in place, the slot is removed by the rollback on error
+                error = parse_field<Prefix>(cursor, column.emplace_back());
+            } else if (auto result = parse<T>(cursor.take())) {
+                column.push_back(std::move(result).value());
+            } else {
+                error = result.error();
+            }
+            return not error;
+        };
+
+        const auto push_row = [&]<bool Prefix>(Str line) {
+            auto cursor = FieldCursor{ Scanner{ line, delim } };
+
+            // short-circuit: stops at the first field that fails
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return (push.template operator()<Prefix>(cursor, std::get<Is>(columns)) and ...);
+            }(Seq{});
+        };
+
+        const auto rollback = [&]<std::size_t... Is>(std::index_sequence<Is...>, std::size_t size) {
+            ((std::get<Is>(columns).size() > size ? std::get<Is>(columns).pop_back() : void()), ...);
+        };
+
+        const auto base = std::get<0>(columns).size();
+
+        // a delimiter that can be part of a number must be found before the number is parsed
+        const auto prefix = can_parse_prefix(delim);
+
+        while (auto next = reader.readline()) {
+            auto line = line_text(next->view());
+            if (line.empty()) {
+                continue;
+            }
+
+            auto pushed = prefix ? push_row.template operator()<true>(line)
+                                 : push_row.template operator()<false>(line);
+            if (not pushed) {
+                rollback(Seq{}, base + rows);
+                return make_error<std::size_t>(error.value());
+            }
+            ++rows;
         }
-        return make_error<Tup<Ts...>>(Error::InvalidInput);
+
+        return make_result<std::size_t>(rows);
     }
 }
 
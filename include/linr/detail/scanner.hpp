@@ -0,0 +1,409 @@
+#ifndef LINR_DETAIL_SCANNER_HPP
+#define LINR_DETAIL_SCANNER_HPP
+
+#include "linr/common.hpp"
+#include "linr/delim.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) or defined(__i386__)) and defined(__GNUC__)
+#    define LINR_SIMD_X86
+#    include <immintrin.h>
+#endif
+
+namespace linr::detail
+{
+    /**
+     * @brief Byte-at-a-time delimiter classifier, usable in constant evaluation.
+     */
+    class ScalarClassifier
+    {
+    public:
+        constexpr ScalarClassifier(Str str, const Delim& delim) noexcept
+            : m_str{ str }
+            , m_delim{ delim }
+        {
+        }
+
+        /**
+         * @brief Find the first non-delimiter character (`Skip`) or the first delimiter or null character
+         * (`not Skip`) starting from `pos`.
+         *
+         * @return The position of the character or the size of the string if not found.
+         */
+        template <bool Skip>
+        constexpr std::size_t next(std::size_t pos) noexcept
+        {
+            for (; pos < m_str.size(); ++pos) {
+                auto is_delim = m_delim.contains(m_str[pos]);
+                if (Skip ? not is_delim : is_delim or m_str[pos] == '\0') {
+                    return pos;
+                }
+            }
+            return m_str.size();
+        }
+
+    protected:
+        Str          m_str;
+        const Delim& m_delim;
+    };
+
+#if defined(LINR_SIMD_X86)
+    namespace simd
+    {
+        /**
+         * @brief Bitmasks of a block of bytes, bit `i` represents byte `i` of the block.
+         */
+        struct Masks
+        {
+            std::uint32_t m_delim;
+            std::uint32_t m_null;
+        };
+
+        __attribute__((target("sse2"))) inline Masks masks_sse2(const char* ptr, const Delim& delim) noexcept
+        {
+            auto block  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            auto delims = _mm_cmpeq_epi8(block, _mm_set1_epi8(delim.first()));
+            auto nulls  = _mm_cmpeq_epi8(block, _mm_setzero_si128());
+            return {
+                static_cast<std::uint32_t>(_mm_movemask_epi8(delims)),
+                static_cast<std::uint32_t>(_mm_movemask_epi8(nulls)),
+            };
+        }
+
+        __attribute__((target("avx2"))) inline Masks masks_avx2(const char* ptr, const Delim& delim) noexcept
+        {
+            auto block  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+            auto delims = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(delim.first()));
+            auto nulls  = _mm256_cmpeq_epi8(block, _mm256_setzero_si256());
+            return {
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(delims)),
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(nulls)),
+            };
+        }
+
+        // sets: look up both nibbles of each byte, the byte is in the set if the looked up bits intersect
+
+        __attribute__((target("ssse3")))
+        inline Masks set_masks_ssse3(const char* ptr, const Delim& delim) noexcept
+        {
+            auto low_table  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(delim.low_nibbles().data()));
+            auto high_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(delim.high_nibbles().data()));
+            auto nibble     = _mm_set1_epi8(0x0F);
+
+            auto block  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+            auto shift  = _mm_srli_epi16(block, 4);
+            auto low    = _mm_shuffle_epi8(low_table, _mm_and_si128(block, nibble));
+            auto high   = _mm_shuffle_epi8(high_table, _mm_and_si128(shift, nibble));
+            auto others = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+            auto nulls  = _mm_cmpeq_epi8(block, _mm_setzero_si128());
+            return {
+                ~static_cast<std::uint32_t>(_mm_movemask_epi8(others)) & 0xFFFF,
+                static_cast<std::uint32_t>(_mm_movemask_epi8(nulls)),
+            };
+        }
+
+        __attribute__((target("avx2")))
+        inline Masks set_masks_avx2(const char* ptr, const Delim& delim) noexcept
+        {
+            auto low_table  = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(delim.low_nibbles().data()))
+            );
+            auto high_table = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(delim.high_nibbles().data()))
+            );
+            auto nibble = _mm256_set1_epi8(0x0F);
+
+            auto block  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+            auto shift  = _mm256_srli_epi16(block, 4);
+            auto low    = _mm256_shuffle_epi8(low_table, _mm256_and_si256(block, nibble));
+            auto high   = _mm256_shuffle_epi8(high_table, _mm256_and_si256(shift, nibble));
+            auto others = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+            auto nulls  = _mm256_cmpeq_epi8(block, _mm256_setzero_si256());
+            return {
+                ~static_cast<std::uint32_t>(_mm256_movemask_epi8(others)),
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(nulls)),
+            };
+        }
+
+        // sets that can't be looked up by nibbles (or no SSSE3): one table lookup per byte
+        inline Masks set_masks_table(const char* ptr, const Delim& delim) noexcept
+        {
+            auto masks = Masks{ 0, 0 };
+            for (std::uint32_t i = 0; i < 16; ++i) {
+                masks.m_delim |= static_cast<std::uint32_t>(delim.contains(ptr[i])) << i;
+                masks.m_null  |= static_cast<std::uint32_t>(ptr[i] == '\0') << i;
+            }
+            return masks;
+        }
+
+        /**
+         * @brief Block mask function selected at runtime based on the CPU and the kind of delimiter.
+         */
+        struct Kernel
+        {
+            using Fn = Masks (*)(const char*, const Delim&) noexcept;
+
+            Fn            m_fn;
+            std::size_t   m_width;
+            std::uint32_t m_full;    // mask with all bits of the block set
+        };
+
+        inline const Kernel& kernel(const Delim& delim) noexcept
+        {
+            static const auto avx2  = __builtin_cpu_supports("avx2") != 0;
+            static const auto ssse3 = __builtin_cpu_supports("ssse3") != 0;
+
+            static const auto chr   = avx2 ? Kernel{ masks_avx2, 32, 0xFFFF'FFFF }    //
+                                           : Kernel{ masks_sse2, 16, 0xFFFF };
+            static const auto set   = avx2  ? Kernel{ set_masks_avx2, 32, 0xFFFF'FFFF }
+                                    : ssse3 ? Kernel{ set_masks_ssse3, 16, 0xFFFF }
+                                            : Kernel{ set_masks_table, 16, 0xFFFF };
+            static const auto table = Kernel{ set_masks_table, 16, 0xFFFF };
+
+            if (delim.kind() != Delim::Kind::Set) {
+                return chr;    // a sequence is found by its first character
+            }
+            return delim.has_nibbles() ? set : table;
+        }
+    }
+
+    /**
+     * @brief Delimiter classifier that classifies 16 (SSE2) or 32 (AVX2) bytes at a time into bitmasks.
+     *
+     * The masks of the last loaded block are kept, so consecutive queries that land on the same block (short
+     * fields) are answered using bit operations only. No load goes past the end of the string, the tail that
+     * is shorter than a block is scanned one byte at a time.
+     */
+    class SimdClassifier
+    {
+    public:
+        SimdClassifier(Str str, const Delim& delim) noexcept
+            : m_str{ str }
+            , m_delim{ delim }
+            , m_kernel{ simd::kernel(delim) }
+        {
+        }
+
+        /**
+         * @brief See `ScalarClassifier::next`.
+         */
+        template <bool Skip>
+        std::size_t next(std::size_t pos) noexcept
+        {
+            while (pos < m_str.size()) {
+                if (pos < m_block or pos >= m_block + m_kernel.m_width) {
+                    // the tail that is shorter than a block is scanned one byte at a time
+                    if (m_str.size() - pos < m_kernel.m_width) {
+                        break;
+                    }
+                    m_block = pos;
+                    m_masks = m_kernel.m_fn(m_str.data() + pos, m_delim);
+                }
+
+                auto bits = Skip ? ~m_masks.m_delim & m_kernel.m_full : m_masks.m_delim | m_masks.m_null;
+                if (bits >>= (pos - m_block); bits != 0) {
+                    return pos + static_cast<std::size_t>(std::countr_zero(bits));
+                }
+                pos = m_block + m_kernel.m_width;
+            }
+
+            for (; pos < m_str.size(); ++pos) {
+                auto is_delim = m_delim.contains(m_str[pos]);
+                if (Skip ? not is_delim : is_delim or m_str[pos] == '\0') {
+                    return pos;
+                }
+            }
+            return m_str.size();
+        }
+
+    protected:
+        Str                 m_str;
+        const Delim&        m_delim;
+        const simd::Kernel& m_kernel;
+        std::size_t         m_block = Str::npos;
+        simd::Masks         m_masks = {};
+    };
+#else
+    using SimdClassifier = ScalarClassifier;
+#endif
+
+    /**
+     * @brief Delimiter scanner on top of a classifier, handles multi-character delimiters (sequences).
+     *
+     * The delimiter is not copied, it must outlive the scanner.
+     */
+    template <typename C>
+    class BasicScanner : private C
+    {
+    public:
+        constexpr BasicScanner(Str str, const Delim& delim) noexcept
+            : C{ str, delim }
+        {
+        }
+
+        constexpr Str          str() const noexcept { return this->m_str; }
+        constexpr const Delim& delim() const noexcept { return this->m_delim; }
+
+        /**
+         * @brief Check whether a delimiter starts at `pos`.
+         */
+        constexpr bool is_delim(std::size_t pos) const noexcept
+        {
+            if (delim().kind() == Delim::Kind::Sequence) {
+                return str().substr(std::min(pos, str().size())).starts_with(delim().sequence());
+            }
+            return pos < str().size() and delim().contains(str()[pos]);
+        }
+
+        /**
+         * @brief Find the first non-delimiter character starting from `start`.
+         *
+         * @return The position of the character or the size of the string if not found.
+         */
+        constexpr std::size_t skip_delim(std::size_t start) noexcept
+        {
+            if (delim().kind() != Delim::Kind::Sequence) {
+                return this->template next<true>(start);
+            }
+            while (is_delim(start)) {
+                start += delim().size();
+            }
+            return std::min(start, str().size());
+        }
+
+        /**
+         * @brief Find the first delimiter or null character starting from `start`.
+         *
+         * @return The position of the character or `Str::npos` if not found.
+         */
+        constexpr std::size_t find_delim_or_null(std::size_t start) noexcept
+        {
+            auto pos = this->template next<false>(start);
+            if (delim().kind() == Delim::Kind::Sequence) {
+                // candidates start with the first character of the sequence
+                while (pos < str().size() and str()[pos] != '\0' and not is_delim(pos)) {
+                    pos = this->template next<false>(pos + 1);
+                }
+            }
+            return pos < str().size() ? pos : Str::npos;
+        }
+    };
+
+    using ScalarScanner = BasicScanner<ScalarClassifier>;
+    using Scanner       = BasicScanner<SimdClassifier>;
+
+    /**
+     * @brief Walks the fields of a line one at a time using a scanner.
+     *
+     * Repeated delimiters are counted as one and the line ends at the first null or newline character (see
+     * `util::split`). A field is consumed either whole (`take()`) or by a parser that reads a prefix of the
+     * rest of the line and reports how far it got (`take(size)`).
+     */
+    template <typename S>
+    class FieldCursor
+    {
+    public:
+        constexpr FieldCursor(S scanner) noexcept
+            : m_scanner{ scanner }
+        {
+        }
+
+        /**
+         * @brief Move to the start of the next field.
+         *
+         * @return False if there are no fields left.
+         */
+        constexpr bool seek() noexcept
+        {
+            const auto str = m_scanner.str();
+            if (m_done or m_pos >= str.size() or str[m_pos] == '\0' or str[m_pos] == '\n') {
+                return false;
+            }
+            m_pos = m_scanner.skip_delim(m_pos);
+            return true;
+        }
+
+        /**
+         * @brief The rest of the line, starting from the current field.
+         */
+        constexpr Str rest() const noexcept { return m_scanner.str().substr(m_pos); }
+
+        /**
+         * @brief Consume the current field.
+         */
+        constexpr Str take() noexcept
+        {
+            const auto str   = m_scanner.str();
+            const auto start = m_pos;
+
+            auto pos = m_scanner.find_delim_or_null(start);
+            if (pos == Str::npos) {
+                m_done = true;
+                return str.substr(start);
+            }
+
+            finish(pos);
+            return str.substr(start, pos - start);
+        }
+
+        /**
+         * @brief Consume the first `size` characters of the current field.
+         *
+         * @return False if those characters are not the whole field; the cursor is left unchanged.
+         */
+        constexpr bool take(std::size_t size) noexcept
+        {
+            const auto str = m_scanner.str();
+            const auto end = m_pos + size;
+
+            if (end == str.size()) {
+                m_pos  = end;
+                m_done = true;
+                return true;
+            } else if (str[end] != '\0' and not m_scanner.is_delim(end)) {
+                return false;
+            }
+
+            finish(end);
+            return true;
+        }
+
+    private:
+        constexpr void finish(std::size_t pos) noexcept
+        {
+            const auto str = m_scanner.str();
+            m_done         = str[pos] == '\0' or str[pos] == '\n';
+            m_pos          = pos + (m_done ? 1 : m_scanner.delim().size());
+        }
+
+        S           m_scanner;
+        std::size_t m_pos  = 0;
+        bool        m_done = false;
+    };
+
+    /**
+     * @brief Split a string into an array of strings using a scanner (see `util::split`).
+     */
+    template <std::size_t N, typename S>
+    constexpr Opt<std::array<Str, N>> split(S scanner) noexcept
+    {
+        std::array<Str, N> res = {};
+
+        auto cursor = FieldCursor<S>{ scanner };
+        for (auto& part : res) {
+            if (not cursor.seek()) {
+                return std::nullopt;
+            }
+            part = cursor.take();
+        }
+
+        return res;
+    }
+}
+
+#endif /* end of include guard: LINR_DETAIL_SCANNER_HPP */
@@ -0,0 +1,509 @@
+#ifndef LINR_DETAIL_URING_READER_HPP
+#define LINR_DETAIL_URING_READER_HPP
+
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace linr::detail
+{
+    /**
+     * @brief Minimal `io_uring` instance (raw syscalls, no liburing) used by `UringReader`.
+     */
+    class Uring
+    {
+    public:
+        /**
+         * @brief Create a ring with room for at least `entries` requests.
+         *
+         * @return The ring or nothing if `io_uring` is not supported (old kernel, disabled by seccomp, etc.).
+         */
+        static Opt<Uring> create(unsigned entries) noexcept
+        {
+            auto params = io_uring_params{};
+            auto fd     = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                return std::nullopt;
+            }
+
+            auto ring = Opt<Uring>{ std::in_place };
+            ring->m_fd = fd;
+
+            auto sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            auto cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            if (params.features & IORING_FEAT_SINGLE_MMAP) {
+                sq_size = cq_size = std::max(sq_size, cq_size);
+            }
+
+            ring->m_sq = Mapping{ fd, sq_size, IORING_OFF_SQ_RING };
+            if (not (params.features & IORING_FEAT_SINGLE_MMAP)) {
+                ring->m_cq = Mapping{ fd, cq_size, IORING_OFF_CQ_RING };
+            }
+            ring->m_sqes = Mapping{ fd, params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES };
+
+            auto* cq = ring->m_cq.m_ptr ? ring->m_cq.m_ptr : ring->m_sq.m_ptr;
+            if (not ring->m_sq.m_ptr or not cq or not ring->m_sqes.m_ptr) {
+                return std::nullopt;
+            }
+
+            ring->m_sq_tail  = ring->m_sq.at<unsigned>(params.sq_off.tail);
+            ring->m_sq_mask  = *ring->m_sq.at<unsigned>(params.sq_off.ring_mask);
+            ring->m_sq_array = ring->m_sq.at<unsigned>(params.sq_off.array);
+            ring->m_cq_head  = static_cast<unsigned*>(static_cast<void*>(cq + params.cq_off.head));
+            ring->m_cq_tail  = static_cast<unsigned*>(static_cast<void*>(cq + params.cq_off.tail));
+            ring->m_cq_mask  = *static_cast<unsigned*>(static_cast<void*>(cq + params.cq_off.ring_mask));
+            ring->m_cqes     = static_cast<io_uring_cqe*>(static_cast<void*>(cq + params.cq_off.cqes));
+            ring->m_features = params.features;
+
+            return ring;
+        }
+
+        Uring() = default;
+
+        ~Uring()
+        {
+            if (m_fd >= 0) {
+                ::close(m_fd);
+            }
+        }
+
+        Uring(Uring&& other) noexcept
+            : m_fd{ std::exchange(other.m_fd, -1) }
+            , m_sq{ std::move(other.m_sq) }
+            , m_cq{ std::move(other.m_cq) }
+            , m_sqes{ std::move(other.m_sqes) }
+            , m_sq_tail{ other.m_sq_tail }
+            , m_sq_array{ other.m_sq_array }
+            , m_cq_head{ other.m_cq_head }
+            , m_cq_tail{ other.m_cq_tail }
+            , m_cqes{ other.m_cqes }
+            , m_sq_mask{ other.m_sq_mask }
+            , m_cq_mask{ other.m_cq_mask }
+            , m_features{ other.m_features }
+            , m_queued{ other.m_queued }
+        {
+        }
+
+        Uring& operator=(Uring&&)      = delete;
+        Uring(const Uring&)            = delete;
+        Uring& operator=(const Uring&) = delete;
+
+        /**
+         * @brief Register buffers, reads into them can then skip the page pinning of each request.
+         */
+        bool register_buffers(const iovec* iovecs, unsigned count) noexcept
+        {
+            return ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, iovecs, count) == 0;
+        }
+
+        /**
+         * @brief Queue a request, it is submitted on the next call to `submit`.
+         *
+         * @return The request to be filled.
+         */
+        io_uring_sqe& queue() noexcept
+        {
+            auto tail  = std::atomic_ref{ *m_sq_tail }.load(std::memory_order_relaxed);
+            auto index = tail & m_sq_mask;
+            auto& sqe  = m_sqes.at<io_uring_sqe>(0)[index];
+
+            std::memset(&sqe, 0, sizeof(sqe));
+            m_sq_array[index] = index;
+            std::atomic_ref{ *m_sq_tail }.store(tail + 1, std::memory_order_release);
+
+            ++m_queued;
+            return sqe;
+        }
+
+        /**
+         * @brief Submit the queued requests, optionally waiting for at least one completion.
+         */
+        bool submit(bool wait) noexcept
+        {
+            auto flags = wait ? IORING_ENTER_GETEVENTS : 0u;
+            while (true) {
+                auto ret = ::syscall(__NR_io_uring_enter, m_fd, m_queued, wait ? 1u : 0u, flags, nullptr, 0);
+                if (ret >= 0) {
+                    m_queued -= std::min(m_queued, static_cast<unsigned>(ret));
+                    return true;
+                } else if (errno != EINTR) {
+                    return false;
+                }
+            }
+        }
+
+        /**
+         * @brief Call `fn(const io_uring_cqe&)` for each available completion.
+         */
+        template <typename Fn>
+        void reap(Fn&& fn) noexcept
+        {
+            auto head = std::atomic_ref{ *m_cq_head }.load(std::memory_order_relaxed);
+            auto tail = std::atomic_ref{ *m_cq_tail }.load(std::memory_order_acquire);
+
+            for (; head != tail; ++head) {
+                fn(m_cqes[head & m_cq_mask]);
+            }
+            std::atomic_ref{ *m_cq_head }.store(head, std::memory_order_release);
+        }
+
+        /**
+         * @brief The `IORING_FEAT_*` flags supported by the kernel.
+         */
+        unsigned features() const noexcept { return m_features; }
+
+    private:
+        struct Mapping
+        {
+            Mapping() = default;
+
+            Mapping(int fd, std::size_t size, std::uint64_t offset) noexcept
+                : m_size{ size }
+            {
+                auto* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                                   static_cast<off_t>(offset));
+                m_ptr     = ptr == MAP_FAILED ? nullptr : static_cast<char*>(ptr);
+            }
+
+            ~Mapping()
+            {
+                if (m_ptr) {
+                    ::munmap(m_ptr, m_size);
+                }
+            }
+
+            Mapping(Mapping&& other) noexcept
+                : m_ptr{ std::exchange(other.m_ptr, nullptr) }
+                , m_size{ other.m_size }
+            {
+            }
+
+            Mapping& operator=(Mapping&& other) noexcept
+            {
+                std::swap(m_ptr, other.m_ptr);
+                std::swap(m_size, other.m_size);
+                return *this;
+            }
+
+            template <typename T>
+            T* at(std::size_t offset) const noexcept
+            {
+                return static_cast<T*>(static_cast<void*>(m_ptr + offset));
+            }
+
+            char*       m_ptr  = nullptr;
+            std::size_t m_size = 0;
+        };
+
+        int           m_fd = -1;
+        Mapping       m_sq;
+        Mapping       m_cq;
+        Mapping       m_sqes;
+        unsigned*     m_sq_tail  = nullptr;
+        unsigned*     m_sq_array = nullptr;
+        unsigned*     m_cq_head  = nullptr;
+        unsigned*     m_cq_tail  = nullptr;
+        io_uring_cqe* m_cqes     = nullptr;
+        unsigned      m_sq_mask  = 0;
+        unsigned      m_cq_mask  = 0;
+        unsigned      m_features = 0;
+        unsigned      m_queued   = 0;
+    };
+
+    /**
+     * @brief Line reader that keeps several large reads of stdin in flight using `io_uring` (Linux only).
+     *
+     * The buffers are registered with the ring once and recycled: as soon as the lines of a buffer are
+     * consumed, a read into it is queued again, so the kernel fills the next buffers while the current one is
+     * parsed, without an extra thread. For a regular file, all the buffers are in flight at once (reads at
+     * explicit offsets); for a pipe, a single read is in flight to keep the data in order. Lines are views
+     * into the buffers, only a line crossing a buffer boundary is copied.
+     *
+     * If `io_uring` is not supported by the kernel, it falls back to `BlockReader`. Since this reader reads
+     * ahead of the current line, it must not be mixed with stdio-based reads of stdin.
+     */
+    class UringReader
+    {
+    public:
+        struct Line
+        {
+            Line(const char* ptr, std::size_t size)
+                : m_str{ ptr, size }
+            {
+            }
+            Str view() const noexcept { return m_str; }
+            Str m_str;
+        };
+
+        static constexpr std::size_t block_size = 1024 * 1024;
+
+        /**
+         * @param buffers Number of buffers, the queue depth for regular files (at least 2).
+         * @param size Size of each buffer.
+         */
+        UringReader(std::size_t buffers = 4, std::size_t size = block_size)
+        {
+            auto count = std::max<std::size_t>(buffers, 2);
+            size       = std::max(size, BlockReader::block_size);
+
+            struct stat info = {};
+            if (::fstat(STDIN_FILENO, &info) == 0 and S_ISREG(info.st_mode)) {
+                auto offset = ::lseek(STDIN_FILENO, 0, SEEK_CUR);
+                m_seekable  = offset >= 0;
+                m_next      = m_expected = offset < 0 ? 0 : static_cast<std::uint64_t>(offset);
+            }
+
+            // room for a read and a cancellation for each buffer; reading a pipe at its current position
+            // needs a 5.6+ kernel
+            auto ring = Uring::create(static_cast<unsigned>(count * 2));
+            if (not ring or (not m_seekable and not (ring->features() & IORING_FEAT_RW_CUR_POS))) {
+                m_fallback.emplace(size);
+                return;
+            }
+            m_ring.emplace(std::move(*ring));
+
+            m_data = std::make_unique_for_overwrite<char[]>(count * size);
+            m_bufs.resize(count);
+            m_iovecs.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                m_iovecs[i] = iovec{ m_data.get() + i * size, size };
+            }
+            m_registered = m_ring->register_buffers(m_iovecs.data(), static_cast<unsigned>(count));
+
+            // a pipe has a single read in flight, queued when the previous one completes
+            for (std::size_t i = 0; i < (m_seekable ? count : 1); ++i) {
+                queue_read(i);
+            }
+            m_ring->submit(false);
+        }
+
+        ~UringReader() { cancel(); }
+
+        UringReader(UringReader&&)            = default;
+        UringReader& operator=(UringReader&&) = delete;
+
+        UringReader(const UringReader&)            = delete;
+        UringReader& operator=(const UringReader&) = delete;
+
+        /**
+         * @brief Check whether stdin is actually read using `io_uring`.
+         */
+        bool is_async() const noexcept { return not m_fallback.has_value(); }
+
+        Opt<Line> readline() noexcept
+        {
+            if (m_fallback) {
+                auto line = m_fallback->readline();
+                if (not line) {
+                    return {};
+                }
+                auto str = line->view();
+                return Opt<Line>{ std::in_place, str.data(), str.size() };
+            }
+
+            // the previous line is no longer needed
+            m_carry.clear();
+            auto carrying = false;
+
+            while (true) {
+                if (not m_held and (m_eof or not acquire())) {
+                    if (carrying) {
+                        // last line without trailing newline
+                        return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+                    }
+                    return {};
+                }
+
+                auto& buf   = m_bufs[m_index];
+                auto* begin = static_cast<const char*>(m_iovecs[m_index].iov_base) + m_pos;
+                auto  rest  = buf.m_size - m_pos;
+
+                if (auto* newline = static_cast<const char*>(std::memchr(begin, '\n', rest))) {
+                    auto size = static_cast<std::size_t>(newline - begin);
+                    m_pos     = m_pos + size + 1;
+
+                    if (not carrying) {
+                        return Opt<Line>{ std::in_place, begin, size };
+                    }
+                    m_carry.insert(m_carry.end(), begin, newline);
+                    return Opt<Line>{ std::in_place, m_carry.data(), m_carry.size() };
+                }
+
+                // the line continues in the next buffer, this is the only place a line is copied
+                m_carry.insert(m_carry.end(), begin, begin + rest);
+                carrying = carrying or rest > 0;
+                release();
+            }
+        }
+
+    private:
+        static constexpr std::uint64_t cancel_tag = ~std::uint64_t{ 0 };
+
+        struct Buffer
+        {
+            std::uint64_t m_offset   = 0;
+            std::size_t   m_size     = 0;
+            int           m_result   = 0;
+            bool          m_inflight = false;
+            bool          m_done     = false;
+        };
+
+        void queue_read(std::size_t index) noexcept
+        {
+            auto& buf = m_bufs[index];
+            auto& sqe = m_ring->queue();
+
+            sqe.fd        = STDIN_FILENO;
+            sqe.user_data = index;
+            sqe.off       = m_seekable ? m_next : ~std::uint64_t{ 0 };    // -1: current position of the pipe
+
+            if (m_registered) {
+                sqe.opcode    = IORING_OP_READ_FIXED;
+                sqe.addr      = reinterpret_cast<std::uint64_t>(m_iovecs[index].iov_base);
+                sqe.len       = static_cast<std::uint32_t>(m_iovecs[index].iov_len);
+                sqe.buf_index = static_cast<std::uint16_t>(index);
+            } else {
+                sqe.opcode = IORING_OP_READV;
+                sqe.addr   = reinterpret_cast<std::uint64_t>(&m_iovecs[index]);
+                sqe.len    = 1;
+            }
+
+            buf.m_offset   = m_next;
+            buf.m_inflight = true;
+            buf.m_done     = false;
+            m_next        += m_iovecs[index].iov_len;
+        }
+
+        void reap() noexcept
+        {
+            m_ring->reap([&](const io_uring_cqe& cqe) {
+                if (cqe.user_data == cancel_tag) {
+                    return;
+                }
+                auto& buf      = m_bufs[cqe.user_data];
+                buf.m_result   = cqe.res;
+                buf.m_inflight = false;
+                buf.m_done     = true;
+            });
+        }
+
+        // wait for the read of the current buffer, returns false at EOF
+        bool acquire() noexcept
+        {
+            auto& buf = m_bufs[m_index];
+
+            while (true) {
+                reap();
+                if (buf.m_done) {
+                    if (buf.m_result == -EINTR or buf.m_result == -EAGAIN) {
+                        m_next = buf.m_offset;
+                        queue_read(m_index);
+                    } else if (m_seekable and buf.m_result >= 0 and buf.m_offset != m_expected) {
+                        // a short read moved the data the later buffers were queued for
+                        m_next = m_expected;
+                        queue_read(m_index);
+                    } else {
+                        break;
+                    }
+                }
+
+                // stdio no longer flushes stdout before reading stdin for us (prompt)
+                std::fflush(stdout);
+                if (not m_ring->submit(true)) {
+                    m_eof = true;
+                    return false;
+                }
+            }
+
+            if (buf.m_result <= 0) {
+                m_eof = true;
+                return false;
+            }
+
+            m_held      = true;
+            m_pos       = 0;
+            buf.m_size  = static_cast<std::size_t>(buf.m_result);
+            m_expected += buf.m_size;
+
+            if (not m_seekable) {
+                // keep the next read in flight while this buffer is parsed
+                m_next = m_expected;
+                queue_read((m_index + 1) % m_bufs.size());
+                m_ring->submit(false);
+            }
+            return true;
+        }
+
+        // queue a read into the consumed buffer and move to the next one
+        void release() noexcept
+        {
+            m_bufs[m_index].m_done = false;
+            if (m_seekable) {
+                queue_read(m_index);
+                m_ring->submit(false);
+            }
+
+            m_index = (m_index + 1) % m_bufs.size();
+            m_held  = false;
+        }
+
+        // the kernel writes into the buffers until the reads complete, they must be cancelled and waited for
+        void cancel() noexcept
+        {
+            if (not m_ring) {
+                return;
+            }
+
+            auto pending = [&] {
+                return std::ranges::any_of(m_bufs, [](const Buffer& buf) { return buf.m_inflight; });
+            };
+
+            for (std::size_t i = 0; i < m_bufs.size(); ++i) {
+                if (m_bufs[i].m_inflight) {
+                    auto& sqe     = m_ring->queue();
+                    sqe.opcode    = IORING_OP_ASYNC_CANCEL;
+                    sqe.addr      = i;
+                    sqe.user_data = cancel_tag;
+                }
+            }
+
+            while (pending() and m_ring->submit(true)) {
+                reap();
+            }
+        }
+
+        Opt<Uring>              m_ring;
+        std::unique_ptr<char[]> m_data;
+        std::vector<iovec>      m_iovecs;
+        std::vector<Buffer>     m_bufs;
+        std::vector<char>       m_carry;
+        std::uint64_t           m_next       = 0;        // offset of the next queued read
+        std::uint64_t           m_expected   = 0;        // offset of the next buffer to be consumed
+        std::size_t             m_index      = 0;        // buffer being read
+        std::size_t             m_pos        = 0;        // start of unconsumed data in the buffer
+        bool                    m_held       = false;    // the buffer is filled and not consumed yet
+        bool                    m_eof        = false;
+        bool                    m_seekable   = false;
+        bool                    m_registered = false;
+        Opt<BlockReader>        m_fallback;
+    };
+    static_assert(LineReader<UringReader>);
+}
+
+#endif /* end of include guard: LINR_DETAIL_URING_READER_HPP */
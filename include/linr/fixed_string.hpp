@@ -0,0 +1,77 @@
+#ifndef LINR_FIXED_STRING_HPP
+#define LINR_FIXED_STRING_HPP
+
+#include "linr/common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace linr
+{
+    /**
+     * @brief String of at most `N` characters stored inline, no allocation.
+     *
+     * Meant for short owned fields (codes, tickers, hostnames) kept in bulk results: a vector of them is a
+     * single contiguous block. Parsing a field longer than `N` fails with `Error::OutOfRange`.
+     *
+     * @tparam N The capacity.
+     */
+    template <std::size_t N>
+    class FixedString
+    {
+    public:
+        static_assert(N > 0, "FixedString must have a non-zero capacity");
+
+        // smallest type that can hold the size
+        using Size = std::conditional_t<(N <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+            std::conditional_t<(N <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::size_t>>;
+
+        constexpr FixedString() noexcept = default;
+
+        /**
+         * @brief Replace the content with a string.
+         *
+         * @return False (and the content is unchanged) if the string is longer than the capacity.
+         */
+        constexpr bool assign(Str str) noexcept
+        {
+            if (str.size() > N) {
+                return false;
+            }
+            std::copy(str.begin(), str.end(), m_data.begin());
+            m_size = static_cast<Size>(str.size());
+            return true;
+        }
+
+        constexpr Str view() const noexcept { return { m_data.data(), m_size }; }
+
+        constexpr operator Str() const noexcept { return view(); }
+
+        constexpr const char* data() const noexcept { return m_data.data(); }
+        constexpr std::size_t size() const noexcept { return m_size; }
+        constexpr bool        empty() const noexcept { return m_size == 0; }
+
+        static constexpr std::size_t capacity() noexcept { return N; }
+
+        friend constexpr bool operator==(const FixedString& lhs, const FixedString& rhs) noexcept
+        {
+            return lhs.view() == rhs.view();
+        }
+
+        friend constexpr bool operator==(const FixedString& lhs, Str rhs) noexcept { return lhs.view() == rhs; }
+
+        friend constexpr auto operator<=>(const FixedString& lhs, const FixedString& rhs) noexcept
+        {
+            return lhs.view() <=> rhs.view();
+        }
+
+    private:
+        std::array<char, N> m_data = {};
+        Size                m_size = 0;
+    };
+}
+
+#endif /* end of include guard: LINR_FIXED_STRING_HPP */
@@ -0,0 +1,200 @@
+#ifndef LINR_PARSE_ALL_HPP
+#define LINR_PARSE_ALL_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace linr
+{
+    namespace detail
+    {
+        /**
+         * @brief Read the whole stdin into memory.
+         *
+         * @return The content of stdin or an error if stdin is in error state.
+         */
+        inline Result<std::vector<char>> read_all() noexcept
+        {
+            auto data = std::vector<char>(256 * 1024);
+            auto size = std::size_t{ 0 };
+
+            while (true) {
+                size += std::fread(data.data() + size, 1, data.size() - size, stdin);
+                if (size < data.size()) {
+                    break;
+                }
+                data.resize(data.size() * 2);
+            }
+
+            if (std::ferror(stdin)) {
+                return make_error<std::vector<char>>(Error::Unknown);
+            }
+
+            data.resize(size);
+            return make_result<std::vector<char>>(std::move(data));
+        }
+
+        /**
+         * @brief Parse every line of a chunk of text in order, empty lines are skipped (a trailing CR is
+         * removed first).
+         *
+         * @param chunk The text to be parsed, a sequence of lines.
+         * @param delim Delimiter between values.
+         * @param out Parsed values are appended here.
+         * @return An error if any line fails to be parsed (parsing stops at the first failure).
+         */
+        template <Parseable... Ts>
+        Opt<Error> parse_chunk(Str chunk, const Delim& delim, std::vector<Tup<Ts...>>& out) noexcept
+        {
+            while (not chunk.empty()) {
+                auto* newline = static_cast<const char*>(std::memchr(chunk.data(), '\n', chunk.size()));
+                auto  size    = newline ? static_cast<std::size_t>(newline - chunk.data()) : chunk.size();
+
+                auto line = chunk.substr(0, size);
+                if (line.ends_with('\r')) {
+                    line.remove_suffix(1);
+                }
+
+                if (not line.empty()) {
+                    auto result = parse_line<Ts...>(line, delim);
+                    if (not result) {
+                        return result.error();
+                    }
+                    out.push_back(std::move(result).value());
+                }
+
+                chunk.remove_prefix(std::min(size + 1, chunk.size()));
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Parse a text on multiple threads; each thread parses a chunk that ends on a line boundary.
+         *
+         * @param text The text to be parsed.
+         * @param threads Number of threads (chunks).
+         * @param delim Delimiter between values.
+         * @return Parsed values in input order, or the first error in input order.
+         */
+        template <Parseable... Ts>
+        Result<std::vector<Tup<Ts...>>> parse_chunks(
+            Str          text,
+            std::size_t  threads,
+            const Delim& delim
+        ) noexcept
+        {
+            // avoid spawning threads for tiny chunks
+            constexpr std::size_t min_chunk_size = 64 * 1024;
+
+            auto max_threads = std::max(threads, std::size_t{ 1 });
+            threads          = std::clamp(text.size() / min_chunk_size, std::size_t{ 1 }, max_threads);
+
+            auto chunks = std::vector<Str>{};
+            auto begin  = std::size_t{ 0 };
+            for (std::size_t i = 1; i <= threads and begin < text.size(); ++i) {
+                auto end = text.size();
+                if (i < threads) {
+                    auto newline = text.find('\n', std::max(begin, text.size() / threads * i));
+                    end          = newline == Str::npos ? text.size() : newline + 1;
+                }
+                chunks.push_back(text.substr(begin, end - begin));
+                begin = end;
+            }
+
+            auto results     = std::vector<std::vector<Tup<Ts...>>>(chunks.size());
+            auto errors      = std::vector<Opt<Error>>(chunks.size());
+            auto first_error = std::atomic<std::size_t>{ chunks.size() };
+
+            auto work = [&](std::size_t i) {
+                // chunks after a failed one won't be part of the result anyway
+                if (first_error.load(std::memory_order_relaxed) < i) {
+                    return;
+                }
+                if ((errors[i] = parse_chunk<Ts...>(chunks[i], delim, results[i]))) {
+                    auto current = first_error.load(std::memory_order_relaxed);
+                    while (i < current and not first_error.compare_exchange_weak(current, i)) { }
+                }
+            };
+
+            auto workers = std::vector<std::thread>{};
+            workers.reserve(chunks.size());
+            for (std::size_t i = 1; i < chunks.size(); ++i) {
+                try {
+                    workers.emplace_back(work, i);
+                } catch (const std::system_error&) {
+                    work(i);    // can't spawn thread, parse on this thread instead
+                }
+            }
+            if (not chunks.empty()) {
+                work(0);
+            }
+
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            auto values = std::vector<Tup<Ts...>>{};
+            auto total  = std::size_t{ 0 };
+            for (std::size_t i = 0; i < chunks.size(); ++i) {
+                if (errors[i]) {
+                    return make_error<std::vector<Tup<Ts...>>>(*errors[i]);
+                }
+                total += results[i].size();
+            }
+
+            values.reserve(total);
+            for (auto& result : results) {
+                std::ranges::move(result, std::back_inserter(values));
+            }
+
+            return make_result<std::vector<Tup<Ts...>>>(std::move(values));
+        }
+    }
+
+    /**
+     * @brief Read the whole stdin and parse every line of it in parallel.
+     *
+     * The input is mapped into memory if stdin is a regular file (POSIX only), otherwise it is read into
+     * memory first. It is then cut into chunks at line boundaries, each parsed on its own thread. The mapping
+     * starts at the position of stdin, so the lines left after earlier reads (eg: a header read with
+     * `linr::read`) are parsed either way.
+     *
+     * @param threads Number of threads used for parsing, defaults to the number of hardware threads.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     * @return Parsed values of each line in input order, or the first error in input order.
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Result<std::vector<Tup<Ts...>>> parse_all(
+        std::size_t threads = std::thread::hardware_concurrency(),
+        Delim       delim   = ' '
+    ) noexcept
+    {
+#if defined(__unix__) or defined(__APPLE__)
+        if (auto mapping = detail::StdinMapping::map()) {
+            auto text = mapping->remaining();
+            mapping->consume(text.size());
+            return detail::parse_chunks<Ts...>(text, threads, delim);
+        }
+#endif
+
+        auto data = detail::read_all();
+        if (not data) {
+            return make_error<std::vector<Tup<Ts...>>>(data.error());
+        }
+        return detail::parse_chunks<Ts...>(Str{ data->data(), data->size() }, threads, delim);
+    }
+}
+
+#endif /* end of include guard: LINR_PARSE_ALL_HPP */
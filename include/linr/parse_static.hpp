@@ -0,0 +1,115 @@
+#ifndef LINR_PARSE_STATIC_HPP
+#define LINR_PARSE_STATIC_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/delim.hpp"
+#include "linr/parser.hpp"
+#include "linr/util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace linr
+{
+    /**
+     * @brief Text embedded in the program, used as a template argument of `parse_static`: a string literal or
+     * a `constexpr` char array (eg: initialized by `#embed`). The text ends at the first NUL, if any.
+     */
+    template <std::size_t N>
+    struct StaticText
+    {
+        constexpr StaticText(const char (&text)[N]) noexcept { std::copy_n(text, N, m_data); }
+
+        constexpr Str view() const noexcept
+        {
+            auto text = Str{ m_data, N };
+            return text.substr(0, text.find('\0'));
+        }
+
+        char m_data[N];
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Call `fn(line)` for each line of a text that is not empty, a trailing CR is removed from the
+         * lines.
+         */
+        template <typename Fn>
+        constexpr void for_each_line(Str text, Fn&& fn)
+        {
+            while (not text.empty()) {
+                auto size = std::min(text.find('\n'), text.size());
+                auto line = text.substr(0, size);
+                if (line.ends_with('\r')) {
+                    line.remove_suffix(1);
+                }
+                if (not line.empty()) {
+                    fn(line);
+                }
+                text.remove_prefix(std::min(size + 1, text.size()));
+            }
+        }
+
+        constexpr std::size_t count_lines(Str text) noexcept
+        {
+            auto count = std::size_t{ 0 };
+            for_each_line(text, [&](Str) { ++count; });
+            return count;
+        }
+
+        // not constexpr: reached in constant evaluation, it fails the build
+        inline void static_parse_failed() noexcept { }
+    }
+
+    /**
+     * @brief Parse every line of an embedded text at compile time, eg: a lookup table shipped as text.
+     *
+     * eg: `constexpr auto table = linr::parse_static<"1 0.5\n2 0.25\n", int, double>();`
+     *
+     * Lines are split with `util::split` and parsed with `parse_into_tuple`, empty lines are skipped. A line
+     * that fails to be parsed fails the build (the diagnostic points at `static_parse_failed`). In constant
+     * evaluation, numbers are parsed by the SWAR and Eisel-Lemire parsers whatever the build flags, so the
+     * floats that need `std::from_chars` (more than 19 significant digits, subnormals, `inf`, `nan`) can't be
+     * parsed.
+     *
+     * @tparam Text The text.
+     * @tparam Ts The types of the values of a line, which must be usable in constant expressions (numbers,
+     * `bool`, `char`, `FixedString`, etc.).
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     * @return The parsed values of each line.
+     */
+    template <StaticText Text, Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::default_initializable<Ts> and ...)
+             and (std::is_trivially_destructible_v<Ts> and ...) and (Owned<Ts> and ...)
+    consteval auto parse_static(Delim delim = ' ') noexcept
+    {
+        // the text is copied, GCC (with `-fsanitize=undefined`) rejects searches into `Text` itself
+        auto text  = Text;
+        auto table = std::array<Tup<Ts...>, detail::count_lines(StaticText{ Text }.view())>{};
+        auto index = std::size_t{ 0 };
+
+        detail::for_each_line(text.view(), [&](Str line) {
+            auto parts = util::split<sizeof...(Ts)>(line, delim);
+            if (not parts) {
+                detail::static_parse_failed();
+                return;
+            }
+
+            auto result = parse_into_tuple<Ts...>(*parts);
+            if (not result) {
+                detail::static_parse_failed();
+                return;
+            }
+            table[index++] = *result;
+        });
+
+        return table;
+    }
+}
+
+#endif /* end of include guard: LINR_PARSE_STATIC_HPP */
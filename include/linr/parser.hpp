@@ -25,6 +25,18 @@ namespace linr
         { p.parse(str) } noexcept -> std::same_as<Result<T>>;
     };
 
+    class Cursor;
+
+    /**
+     * @brief Custom types whose parser pulls the tokens it needs from a `Cursor` (`parse(Cursor&)`)
+     * instead of being given a single field. Such types can span several fields and be composed, in a
+     * single scan of the line.
+     */
+    template <typename T>
+    concept CursorParseable = requires (const CustomParser<T> p, Cursor& cursor) {
+        { p.parse(cursor) } noexcept -> std::same_as<Result<T>>;
+    };
+
     template <typename T>
     concept DefaultParseable = requires (const detail::DefaultParser<T> p, Str str) {
         { p.parse(str) } noexcept -> std::same_as<Result<T>>;
@@ -37,7 +49,7 @@ namespace linr
      * @brief Helper function that calls the specialized `Parser` member function.
      */
     template <Parseable T>
-    Result<T> parse(Str str) noexcept
+    constexpr Result<T> parse(Str str) noexcept
     {
         if constexpr (CustomParseable<T>) {
             return CustomParser<T>{}.parse(str);
@@ -0,0 +1,195 @@
+#ifndef LINR_PIPELINE_HPP
+#define LINR_PIPELINE_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/detail/batch_reader.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/shared_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace linr
+{
+    /**
+     * @brief Ordered parallel parsing of stdin with bounded memory, meant for endless piped streams.
+     *
+     * Three stages:
+     * - I/O: a dedicated thread reads stdin into batches of lines (see `detail::BatchReader`);
+     * - parse: worker threads pull the batches from a lock-free MPMC queue as soon as they are free, so a
+     *   slow batch doesn't hold the other workers back, and parse them;
+     * - reorder: the thread calling `run` delivers the parsed batches to a callback in input order.
+     *
+     * A batch is in flight from the moment it is read until the callback returns, and the number of batches
+     * in flight is capped, so the memory stays flat however long the stream is.
+     *
+     * @tparam R The line reader used by the I/O thread.
+     * @tparam Ts The types of the values of a line.
+     */
+    template <detail::LineReader R, Parseable... Ts>
+        requires std::default_initializable<R> and (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+             and (Owned<Ts> and ...)
+    class BasicPipeline
+    {
+    public:
+        using Batch = linr::Batch<Ts...>;
+
+        /**
+         * @param threads Number of parser workers, defaults to the number of hardware threads.
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         * @param batch_lines Number of lines of a batch.
+         * @param max_in_flight Maximum number of batches in flight, defaults to four per worker.
+         */
+        explicit BasicPipeline(
+            std::size_t threads       = std::thread::hardware_concurrency(),
+            Delim       delim         = ' ',
+            std::size_t batch_lines   = 1024,
+            std::size_t max_in_flight = 0
+        ) noexcept
+            : m_threads{ std::max<std::size_t>(threads, 1) }
+            , m_delim{ delim }
+            , m_batch_lines{ batch_lines }
+            , m_max_in_flight{ max_in_flight > 0 ? max_in_flight : m_threads * 4 }
+        {
+        }
+
+        /**
+         * @brief Read stdin until EOF, delivering every parsed batch to a callback in input order.
+         *
+         * When stopped, the I/O thread stops after the line it is reading, but `run` still waits for that
+         * pending blocking read of stdin to return: on a stream that goes quiet, until its next line or EOF.
+         *
+         * @param fn Called as `fn(Batch&)` on the calling thread, one batch at a time. It may return `bool`,
+         * `false` stops the pipeline (the batches in flight are dropped).
+         * @return Number of lines delivered.
+         */
+        template <typename Fn>
+            requires std::invocable<Fn&, Batch&>
+        std::uint64_t run(Fn&& fn)
+        {
+            auto reader = detail::BatchReader<R>{ m_batch_lines, m_max_in_flight };
+            auto slots  = std::make_unique<Slot[]>(m_max_in_flight);
+            auto state  = State{};
+
+            const auto work = [&] {
+                while (auto lines = reader.take()) {
+                    // at most `m_max_in_flight` batches are in flight, so the slot is free
+                    auto& slot   = slots[lines->m_seq % m_max_in_flight];
+                    slot.m_batch = detail::parse_batch<Ts...>(*lines, m_delim);
+                    slot.m_ready.store(true, std::memory_order_release);
+                    state.wake();
+                }
+                if (state.m_running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    state.wake();    // the last worker is done
+                }
+            };
+
+            state.m_running.store(m_threads, std::memory_order_relaxed);
+
+            auto workers = std::vector<std::jthread>{};
+
+            // on exit (even by exception, spawning included), stop reading so the workers can be joined: the
+            // guard is destroyed before the workers
+            struct StopGuard
+            {
+                ~StopGuard() { m_reader.stop(); }
+                detail::BatchReader<R>& m_reader;
+            } guard{ reader };
+
+            workers.reserve(m_threads);
+            for (std::size_t i = 0; i < m_threads; ++i) {
+                workers.emplace_back(work);
+            }
+
+            auto lines = std::uint64_t{ 0 };
+            for (std::uint64_t next = 0;; ++next) {
+                auto& slot = slots[next % m_max_in_flight];
+                if (not state.wait_for(slot.m_ready)) {
+                    break;
+                }
+
+                auto batch = std::move(slot.m_batch);
+                slot.m_ready.store(false, std::memory_order_relaxed);
+                lines += batch.size();
+
+                auto proceed = true;
+                if constexpr (std::same_as<std::invoke_result_t<Fn&, Batch&>, bool>) {
+                    proceed = std::invoke(fn, batch);
+                } else {
+                    std::invoke(fn, batch);
+                }
+
+                // the batch is delivered, the I/O thread can read another
+                reader.release();
+                if (not proceed) {
+                    break;
+                }
+            }
+
+            return lines;
+        }
+
+    private:
+        struct Slot
+        {
+            Batch             m_batch;
+            std::atomic<bool> m_ready = false;
+        };
+
+        // wakes the reorder stage up when a batch is parsed or the workers are done
+        struct State
+        {
+            std::atomic<std::uint64_t> m_events  = 0;
+            std::atomic<std::size_t>   m_running = 0;
+
+            void wake() noexcept
+            {
+                m_events.fetch_add(1, std::memory_order_release);
+                m_events.notify_one();
+            }
+
+            // wait until the batch is parsed, returns false if it never will be
+            bool wait_for(const std::atomic<bool>& ready) noexcept
+            {
+                while (true) {
+                    auto events = m_events.load(std::memory_order_acquire);
+
+                    if (ready.load(std::memory_order_acquire)) {
+                        return true;
+                    }
+                    if (m_running.load(std::memory_order_acquire) == 0) {
+                        return ready.load(std::memory_order_acquire);
+                    }
+
+                    m_events.wait(events, std::memory_order_acquire);
+                }
+            }
+        };
+
+        std::size_t m_threads;
+        Delim       m_delim;
+        std::size_t m_batch_lines;
+        std::size_t m_max_in_flight;
+    };
+
+#if defined(__unix__) or defined(__APPLE__)
+    /**
+     * @brief Pipeline whose I/O thread reads stdin in large blocks, see `BasicPipeline`.
+     */
+    template <Parseable... Ts>
+    using Pipeline = BasicPipeline<detail::BlockReader, Ts...>;
+#else
+    template <Parseable... Ts>
+    using Pipeline = BasicPipeline<detail::Reader, Ts...>;
+#endif
+}
+
+#endif /* end of include guard: LINR_PIPELINE_HPP */
@@ -1,19 +1,29 @@
 #ifndef LINR_READ_HPP
 #define LINR_READ_HPP
 
+#include "linr/borrowed.hpp"
+#include "linr/detail/csv.hpp"
+#include "linr/detail/fixed_width.hpp"
+#include "linr/detail/format.hpp"
 #include "linr/detail/read.hpp"
 
 namespace linr
 {
+    // the free read functions don't retain their line buffer, so `Borrowed` values can't be read with them
+    // (use `BasicBufReader` instead)
+
     /**
      * @brief Read multiple values from stdin.
      *
+     * Fields can be skipped without being parsed using `Skip` or `Ignore<N>`, they are left out of the
+     * result.
+     *
      * @param prompt The prompt.
-     * @param delim Delimiter, only `char` so you can't use unicode.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
      */
-    template <Parseable... Ts>
-        requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...)
-    Results<Ts...> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+    template <detail::Projectable... Ts>
+        requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Result<detail::Projected<Ts...>> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
     {
         auto reader = detail::Reader{};
         return detail::read_impl<Ts...>(reader, prompt, delim);
@@ -22,12 +32,15 @@ namespace linr
     /**
      * @brief Read a single value from stdin.
      *
+     * An aggregate is read member by member from consecutive fields (see `detail::Reflectable`), eg:
+     * `read<Point>()` for `struct Point { int x; float y; };`.
+     *
      * @param prompt The prompt.
-     * @param delim Delimiter, only `char` so you can't use unicode.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
      */
-    template <Parseable T>
-        requires std::movable<T>
-    Result<T> read(Opt<Str> prompt = std::nullopt, char delim = ' ') noexcept
+    template <detail::Readable T>
+        requires std::movable<T> and Owned<T>
+    Result<T> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
     {
         auto reader = detail::Reader{};
         auto result = detail::read_impl<T>(reader, prompt, delim);
@@ -37,6 +50,138 @@ namespace linr
         return make_error<T>(result.error());
     }
 
+    /**
+     * @brief Read every value of a line from stdin into a vector, eg: `read<std::vector<int>>()`.
+     *
+     * @param prompt The prompt.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     */
+    template <detail::ParseableVector V>
+        requires std::movable<typename V::value_type> and Owned<typename V::value_type>
+    Result<V> read(Opt<Str> prompt = std::nullopt, Delim delim = ' ') noexcept
+    {
+        auto reader = detail::Reader{};
+        auto values = V{};
+        auto result = detail::read_into_impl(reader, prompt, delim, values);
+        if (result) {
+            return make_result<V>(std::move(values));
+        }
+        return make_error<V>(result.error());
+    }
+
+    /**
+     * @brief Read every value of a line from stdin into a vector that is reused across calls.
+     *
+     * The vector is cleared before the line is parsed, its capacity is kept. On a parse error, the values
+     * parsed before the failing field are kept; at EOF the vector is left as is.
+     *
+     * @param values The vector, allocator-aware values are allocated from its memory resource if it is a
+     * `std::pmr::vector`.
+     * @param prompt The prompt.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     * @return Number of values read or the error.
+     */
+    template <Parseable T, typename A>
+        requires std::movable<T> and Owned<T>
+    Result<std::size_t> read_into(
+        std::vector<T, A>& values,
+        Opt<Str>           prompt = std::nullopt,
+        Delim              delim  = ' '
+    ) noexcept
+    {
+        auto reader = detail::Reader{};
+        return detail::read_into_impl(reader, prompt, delim, values);
+    }
+
+    /**
+     * @brief Read multiple values from stdin using a format string (see `FormatString`).
+     *
+     * The format is checked at compile time and a matcher specialized for it is generated.
+     *
+     * @tparam F The format, eg: `"{}, id:{}"`.
+     * @param prompt The prompt.
+     */
+    template <FormatString F, Parseable... Ts>
+        requires (sizeof...(Ts) > 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Results<Ts...> read(Opt<Str> prompt = std::nullopt) noexcept
+    {
+        auto reader = detail::Reader{};
+        return detail::read_format_impl<F, Ts...>(reader, prompt);
+    }
+
+    /**
+     * @brief Read a single value from stdin using a format string (see `FormatString`).
+     *
+     * @tparam F The format, eg: `"id:{}"`.
+     * @param prompt The prompt.
+     */
+    template <FormatString F, Parseable T>
+        requires std::movable<T> and Owned<T>
+    Result<T> read(Opt<Str> prompt = std::nullopt) noexcept
+    {
+        auto reader = detail::Reader{};
+        auto result = detail::read_format_impl<F, T>(reader, prompt);
+        if (result) {
+            return make_result<T>(std::get<0>(std::move(result).value()));
+        }
+        return make_error<T>(result.error());
+    }
+
+    /**
+     * @brief Read multiple values from a fixed-width record on stdin (see `Field`).
+     *
+     * The columns are sliced at their compile-time offsets, the line isn't scanned for delimiters.
+     *
+     * @tparam Fs The columns, eg: `Field<int, 0, 8>, Field<double, 8, 12>`.
+     * @param prompt The prompt.
+     */
+    template <detail::FixedField... Fs>
+        requires (sizeof...(Fs) > 1) and (std::movable<typename Fs::Type> and ...)
+             and (Owned<typename Fs::Type> and ...)
+    Results<typename Fs::Type...> read_fixed(Opt<Str> prompt = std::nullopt) noexcept
+    {
+        auto reader = detail::Reader{};
+        return detail::read_fixed_impl<Fs...>(reader, prompt);
+    }
+
+    /**
+     * @brief Read a single value from a fixed-width record on stdin (see `Field`).
+     *
+     * @tparam F The column, eg: `Field<int, 0, 8>`.
+     * @param prompt The prompt.
+     */
+    template <detail::FixedField F>
+        requires std::movable<typename F::Type> and Owned<typename F::Type>
+    Result<typename F::Type> read_fixed(Opt<Str> prompt = std::nullopt) noexcept
+    {
+        using T = typename F::Type;
+
+        auto reader = detail::Reader{};
+        auto result = detail::read_fixed_impl<F>(reader, prompt);
+        if (result) {
+            return make_result<T>(std::get<0>(std::move(result).value()));
+        }
+        return make_error<T>(result.error());
+    }
+
+    /**
+     * @brief Read the first values of a CSV record (RFC 4180) from stdin.
+     *
+     * Quoted fields may contain delimiters, doubled quotes and newlines (the record then continues on the
+     * next lines). Fields after the last value are ignored.
+     *
+     * @param prompt The prompt.
+     * @param delim The delimiter.
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Results<Ts...> read_csv(Opt<Str> prompt = std::nullopt, char delim = ',') noexcept
+    {
+        auto reader  = detail::Reader{};
+        auto buffers = detail::CsvBuffers{};
+        return detail::read_csv_impl<Ts...>(reader, prompt, delim, buffers);
+    }
+
     /**
      * @brief Read a string until '\n' is found (aka getline)
      *
@@ -51,6 +196,46 @@ namespace linr
         }
         return make_error<std::string>(result.error());
     }
+
+    /**
+     * @brief Read the rest of stdin into columns, one `std::vector` for each value of a line.
+     *
+     * Empty lines are skipped.
+     *
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     * @return The columns or the error that stops the read.
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Result<Tup<std::vector<Ts>...>> read_columns(Delim delim = ' ') noexcept
+    {
+        auto reader  = detail::BufReader{ 1024 };
+        auto columns = Tup<std::vector<Ts>...>{};
+        auto result  = detail::read_columns_impl<Ts...>(reader, columns, delim);
+        if (result) {
+            return make_result<Tup<std::vector<Ts>...>>(std::move(columns));
+        }
+        return make_error<Tup<std::vector<Ts>...>>(result.error());
+    }
+
+    /**
+     * @brief Read the rest of stdin, appending each value of a line into its column.
+     *
+     * Empty lines are skipped.
+     *
+     * On error, rows that are read before the error are kept in the columns.
+     *
+     * @param columns The columns, can be reused across calls.
+     * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+     * @return Number of rows appended or the error that stops the read.
+     */
+    template <Parseable... Ts>
+        requires (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...) and (Owned<Ts> and ...)
+    Result<std::size_t> read_columns(Tup<std::vector<Ts>...>& columns, Delim delim = ' ') noexcept
+    {
+        auto reader = detail::BufReader{ 1024 };
+        return detail::read_columns_impl<Ts...>(reader, columns, delim);
+    }
 }
 
 #endif /* end of include guard: LINR_READ_HPP */
@@ -0,0 +1,151 @@
+#ifndef LINR_SHARED_READER_HPP
+#define LINR_SHARED_READER_HPP
+
+#include "linr/borrowed.hpp"
+#include "linr/common.hpp"
+#include "linr/detail/batch_reader.hpp"
+#include "linr/detail/line_reader.hpp"
+#include "linr/detail/read.hpp"
+#include "linr/parser.hpp"
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace linr
+{
+    /**
+     * @brief Parsed lines of a batch of stdin, in input order (see `BasicSharedReader` and `BasicPipeline`).
+     */
+    template <Parseable... Ts>
+    class Batch
+    {
+    public:
+        Batch() = default;
+
+        Batch(std::uint64_t seq, std::uint64_t first_line, std::vector<Results<Ts...>> records) noexcept
+            : m_seq{ seq }
+            , m_first_line{ first_line }
+            , m_records{ std::move(records) }
+        {
+        }
+
+        /**
+         * @brief Sequence number of the batch, batches are numbered from 0 in input order.
+         */
+        std::uint64_t seq() const noexcept { return m_seq; }
+
+        /**
+         * @brief Line number (from 0) of the first record, record `i` is line `first_line() + i`.
+         */
+        std::uint64_t first_line() const noexcept { return m_first_line; }
+
+        /**
+         * @brief The parsed values (or the error) of each line.
+         */
+        std::span<Results<Ts...>> records() noexcept { return m_records; }
+
+        std::size_t size() const noexcept { return m_records.size(); }
+
+        auto begin() noexcept { return m_records.begin(); }
+        auto end() noexcept { return m_records.end(); }
+
+    private:
+        std::uint64_t               m_seq        = 0;
+        std::uint64_t               m_first_line = 0;
+        std::vector<Results<Ts...>> m_records;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Parse the lines of a batch.
+         */
+        template <Parseable... Ts>
+        Batch<Ts...> parse_batch(const LineBatch& lines, const Delim& delim) noexcept
+        {
+            auto records = std::vector<Results<Ts...>>{};
+            records.reserve(lines.size());
+            lines.for_each([&](Str line) { records.push_back(parse_line<Ts...>(line, delim)); });
+            return Batch<Ts...>{ lines.m_seq, lines.m_first_line, std::move(records) };
+        }
+    }
+
+    /**
+     * @brief Thread-safe reader that hands the lines of stdin out to several worker threads in batches.
+     *
+     * A dedicated I/O thread reads stdin using a line reader, copies the lines into batches and pushes them
+     * into a lock-free MPMC queue (bounded, so reading stops while the workers are busy), see
+     * `detail::BatchReader`. Each call to `pop` takes a batch from the queue and parses its lines on the
+     * calling thread, so the parsing is spread across the workers. Batches are numbered in input order so
+     * the order can be restored.
+     *
+     * Since the I/O thread reads ahead, this reader must not be mixed with other reads of stdin. On
+     * destruction, the I/O thread stops after the line it is reading, but the pending blocking read of stdin
+     * still has to return: on a stream that goes quiet, the destructor waits for its next line or EOF.
+     *
+     * @tparam R The line reader used by the I/O thread.
+     * @tparam Ts The types of the values of a line.
+     */
+    template <detail::LineReader R, Parseable... Ts>
+        requires std::default_initializable<R> and (sizeof...(Ts) >= 1) and (std::movable<Ts> and ...)
+             and (Owned<Ts> and ...)
+    class BasicSharedReader
+    {
+    public:
+        using Batch = linr::Batch<Ts...>;
+
+        /**
+         * @param delim Delimiter: a character, a set of characters or a sequence (see `Delim`).
+         * @param batch_lines Number of lines of a batch.
+         * @param capacity Number of batches queued ahead of the workers.
+         */
+        explicit BasicSharedReader(
+            Delim       delim       = ' ',
+            std::size_t batch_lines = 1024,
+            std::size_t capacity    = 64
+        )
+            : m_delim{ delim }
+            , m_reader{ batch_lines, capacity }
+        {
+        }
+
+        /**
+         * @brief Take the next batch of lines and parse it, can be called from any number of threads.
+         *
+         * Blocks until a batch is available.
+         *
+         * @return The batch, or nothing once every line of stdin is handed out.
+         */
+        Opt<Batch> pop() noexcept
+        {
+            auto lines = m_reader.take();
+            if (not lines) {
+                return std::nullopt;
+            }
+
+            // the batch is out of the queue, the I/O thread can read another
+            m_reader.release();
+            return detail::parse_batch<Ts...>(*lines, m_delim);
+        }
+
+    private:
+        const Delim            m_delim;
+        detail::BatchReader<R> m_reader;
+    };
+
+#if defined(__unix__) or defined(__APPLE__)
+    /**
+     * @brief Shared reader whose I/O thread reads stdin in large blocks, see `BasicSharedReader`.
+     */
+    template <Parseable... Ts>
+    using SharedReader = BasicSharedReader<detail::BlockReader, Ts...>;
+#else
+    template <Parseable... Ts>
+    using SharedReader = BasicSharedReader<detail::Reader, Ts...>;
+#endif
+}
+
+#endif /* end of include guard: LINR_SHARED_READER_HPP */
@@ -0,0 +1,126 @@
+#ifndef LINR_SKIP_HPP
+#define LINR_SKIP_HPP
+
+#include "linr/common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace linr
+{
+    /**
+     * @brief Placeholder for `N` fields of a line that are skipped: they are found but never parsed, and they
+     * are left out of the result, eg: `read<Skip, int, Ignore<2>, double>()` returns `Tup<int, double>`.
+     *
+     * Parsing stops once the last wanted field is found, so the trailing fields aren't needed.
+     */
+    template <std::size_t N>
+        requires (N >= 1)
+    struct Ignore
+    {
+    };
+
+    /**
+     * @brief Placeholder for a single skipped field, see `Ignore`.
+     */
+    using Skip = Ignore<1>;
+
+    namespace detail
+    {
+        /**
+         * @brief Number of fields a type stands for: `N` for `Ignore<N>`, 1 otherwise.
+         */
+        template <typename>
+        struct FieldWidth : std::integral_constant<std::size_t, 1>
+        {
+        };
+
+        template <std::size_t N>
+        struct FieldWidth<Ignore<N>> : std::integral_constant<std::size_t, N>
+        {
+        };
+
+        template <typename>
+        struct IsIgnore : std::false_type
+        {
+        };
+
+        template <std::size_t N>
+        struct IsIgnore<Ignore<N>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        concept Skipped = IsIgnore<T>::value;
+
+        template <typename T, typename Tuple>
+        struct Prepend;
+
+        template <typename T, typename... Us>
+        struct Prepend<T, Tup<Us...>>
+        {
+            using type = Tup<T, Us...>;
+        };
+
+        template <typename... Ts>
+        struct Project
+        {
+            using type = Tup<>;
+        };
+
+        template <typename T, typename... Ts>
+        struct Project<T, Ts...>
+        {
+            using Rest = typename Project<Ts...>::type;
+            using type = std::conditional_t<Skipped<T>, Rest, typename Prepend<T, Rest>::type>;
+        };
+
+        /**
+         * @brief The tuple of the types that are not skipped.
+         */
+        template <typename... Ts>
+        using Projected = typename Project<Ts...>::type;
+
+        /**
+         * @brief Number of fields of a line described by the types.
+         */
+        template <typename... Ts>
+        inline constexpr std::size_t field_count = (FieldWidth<Ts>::value + ... + 0);
+
+        /**
+         * @brief Index in the result of the `K`-th type (the number of types before it that are not skipped).
+         */
+        template <std::size_t K, typename... Ts>
+        inline constexpr std::size_t projected_index = [] {
+            constexpr auto skipped = std::array<bool, sizeof...(Ts)>{ Skipped<Ts>... };
+            auto           index   = std::size_t{ 0 };
+            for (std::size_t i = 0; i < K; ++i) {
+                index += skipped[i] ? 0 : 1;
+            }
+            return index;
+        }();
+
+        /**
+         * @brief Field index of each type that is not skipped, in order.
+         */
+        template <typename... Ts>
+        inline constexpr auto kept_fields = [] {
+            constexpr auto widths  = std::array<std::size_t, sizeof...(Ts)>{ FieldWidth<Ts>::value... };
+            constexpr auto skipped = std::array<bool, sizeof...(Ts)>{ Skipped<Ts>... };
+
+            auto fields = std::array<std::size_t, std::tuple_size_v<Projected<Ts...>>>{};
+            auto field  = std::size_t{ 0 };
+            auto kept   = std::size_t{ 0 };
+            for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+                if (not skipped[i]) {
+                    fields[kept++] = field;
+                }
+                field += widths[i];
+            }
+            return fields;
+        }();
+    }
+}
+
+#endif /* end of include guard: LINR_SKIP_HPP */
@@ -1,12 +1,28 @@
 // #undef LINR_ENABLE_GETLINE    // uncomment this to use fgets instead of getline
 
 #include <linr/buf_read.hpp>
+#include <linr/parse_all.hpp>
+#include <linr/parse_static.hpp>
+#include <linr/pipeline.hpp>
 #include <linr/read.hpp>
 
 #include <boost/ut.hpp>
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
 namespace ut = boost::ut;
 
 struct Idk
@@ -44,6 +60,134 @@ struct linr::CustomParser<Idk>
     }
 };
 
+struct Point
+{
+    int   m_x;
+    float m_y;
+};
+
+struct Segment
+{
+    Point m_from;
+    Point m_to;
+};
+
+template <>
+struct linr::CustomParser<Segment>
+{
+    // "x y -> x y", the points are parsed from the same cursor
+    Result<Segment> parse(Cursor& cursor) const noexcept
+    {
+        auto from = cursor.parse<Point>();
+        if (not from) {
+            return make_error<Segment>(from.error());
+        }
+        if (cursor.next() != "->") {
+            return make_error<Segment>(Error::InvalidInput);
+        }
+        auto to = cursor.parse<Point>();
+        if (not to) {
+            return make_error<Segment>(to.error());
+        }
+        return make_result<Segment>(*from, *to);
+    }
+};
+
+// line reader over in-memory lines, for the functions that take a `LineReader`
+struct MemReader
+{
+    struct Line
+    {
+        linr::Str view() const noexcept { return m_str; }
+
+        linr::Str m_str;
+    };
+
+    linr::Opt<Line> readline() noexcept
+    {
+        if (m_index == m_lines.size()) {
+            return {};
+        }
+        return Line{ m_lines[m_index++] };
+    }
+
+    std::vector<linr::Str> m_lines;
+    std::size_t            m_index = 0;
+};
+
+// line reader producing the lines "i -i" for i in [0, 1000), for the readers that construct their own
+struct CountReader
+{
+    struct Line
+    {
+        linr::Str view() const noexcept { return m_str; }
+
+        std::string m_str;
+    };
+
+    linr::Opt<Line> readline() noexcept
+    {
+        if (m_index == 1000) {
+            return {};
+        }
+        auto index = m_index++;
+        return Line{ std::to_string(index) + ' ' + std::to_string(-index) + '\n' };
+    }
+
+    int m_index = 0;
+};
+
+#if defined(LINR_ENABLE_ZLIB)
+// block source returning its chunks one read at a time, like a pipe
+struct ChunkSource
+{
+    std::size_t read(char* out, std::size_t size) noexcept
+    {
+        if (m_index == m_chunks.size()) {
+            return 0;
+        }
+
+        auto& chunk = m_chunks[m_index];
+        auto  count = std::min(size, chunk.size());
+        std::memcpy(out, chunk.data(), count);
+        chunk.remove_prefix(count);
+        m_index += chunk.empty() ? 1 : 0;
+        return count;
+    }
+
+    std::vector<linr::Str> m_chunks;
+    std::size_t            m_index = 0;
+};
+
+std::string gzip(std::string_view text)
+{
+    auto stream = z_stream{};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+
+    auto out = std::string(deflateBound(&stream, static_cast<uLong>(text.size())), '\0');
+
+    stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+    stream.avail_in  = static_cast<uInt>(text.size());
+    stream.next_out  = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// read a block source (or decode a compressed input) until its end
+std::string read_all(auto&& read)
+{
+    auto text  = std::string{};
+    auto block = std::array<char, 64>{};
+    while (auto size = read(block.data(), block.size())) {
+        text.append(block.data(), size);
+    }
+    return text;
+}
+#endif
+
 void test(auto&& read)
 {
     using namespace ut::literals;
@@ -131,8 +275,363 @@ void test(auto&& read)
     };
 }
 
+void test_parse()
+{
+    using namespace ut::literals;
+    using ut::expect;
+
+    "integer parser has the same semantics as std::from_chars"_test = [] {
+        auto inputs = {
+            "0", "-0", "42", "12345678", "2147483647", "2147483648", "-2147483648", "-2147483649",
+            "000000000000000000000042", "99999999999999999999", "-", "", "abc", "--1", "+1",
+        };
+
+        for (std::string_view str : inputs) {
+            auto value   = 0;
+            auto [_, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            auto result  = linr::parse<int>(str);
+
+            if (ec == std::errc::invalid_argument) {
+                expect(not result and result.error() == linr::Error::InvalidInput) << str;
+            } else if (ec == std::errc::result_out_of_range) {
+                expect(not result and result.error() == linr::Error::OutOfRange) << str;
+            } else {
+                expect(result and result.value() == value) << str;
+            }
+        }
+    };
+
+    "floating point parser is bit-identical to std::from_chars"_test = [] {
+        auto inputs = {
+            "0",      "-0.0",   "3.14159",      "1e10",    "1.5e-7",  "2.2250738585072014e-308",
+            "4e-320", "1e400",  "-1e-400",      "0.1e1",   "1.e5",    "1E+2",
+            ".5",     "inf",    "-nan",         "9007199254740993",   "1.7976931348623157e308",
+            "1.",     "abc",    "",             "-",       "123456789012345678901234567890",
+        };
+
+        for (std::string_view str : inputs) {
+            auto value   = 0.0;
+            auto [_, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+            auto result  = linr::parse<double>(str);
+
+            if (ec == std::errc::invalid_argument) {
+                expect(not result and result.error() == linr::Error::InvalidInput) << str;
+            } else if (ec == std::errc::result_out_of_range) {
+                expect(not result and result.error() == linr::Error::OutOfRange) << str;
+            } else if (value != value) {
+                expect(result and result.value() != result.value()) << str;
+            } else {
+                auto bits = std::bit_cast<std::uint64_t>(value);
+                expect(result and std::bit_cast<std::uint64_t>(result.value()) == bits) << str;
+            }
+        }
+    };
+
+    "split using delimiter sets and sequences"_test = [] {
+        auto set = linr::util::split<3>("1 \t|2|3", linr::Delim::any_of(" \t|"));
+        expect(set and set->at(0) == "1" and set->at(1) == "2" and set->at(2) == "3");
+
+        auto whitespace = linr::util::split<2>("  a\t\v b  ", linr::Delim::whitespace());
+        expect(whitespace and whitespace->at(0) == "a" and whitespace->at(1) == "b");
+
+        auto sequence = linr::util::split<3>("a::b:c::::d", linr::Delim::sequence("::"));
+        expect(sequence and sequence->at(0) == "a" and sequence->at(1) == "b:c" and sequence->at(2) == "d");
+    };
+
+    "numbers with trailing characters are rejected"_test = [] {
+        expect(linr::parse<int>("12abc").error() == linr::Error::InvalidInput);
+        expect(linr::parse<double>("1.5x").error() == linr::Error::InvalidInput);
+        expect(linr::parse<double>("1e").error() == linr::Error::InvalidInput);
+    };
+
+    "crlf line endings are not part of the last field"_test = [] {
+        auto result = linr::detail::parse_line<int, double>("1 2.5\r", ' ');
+        expect(result and *result == linr::Tup<int, double>{ 1, 2.5 });
+
+        // getline and fgets leave NULs after the line
+        auto padded = linr::detail::parse_line<std::string, int>(linr::Str{ "ab 12\r\0\0", 7 }, ' ');
+        expect(padded and std::get<1>(*padded) == 12);
+
+        auto fixed = linr::detail::parse_fixed<linr::Field<int, 0, 4>>("12\r");
+        expect(fixed and std::get<0>(*fixed) == 12);
+    };
+
+    "skipped fields are left out of the result"_test = [] {
+        using linr::Ignore, linr::Skip;
+
+        auto result = linr::detail::parse_line<Skip, int, Ignore<2>, double>("x 1 y z 2.5 w", ' ');
+        expect(result and std::get<0>(*result) == 1 and std::get<1>(*result) == 2.5);
+
+        auto missing = linr::detail::parse_line<Skip, int, Skip, int>("x 1 y", ' ');
+        expect(not missing and missing.error() == linr::Error::InvalidInput);
+    };
+
+    "fixed-width columns are sliced at their offsets and trimmed"_test = [] {
+        using Id    = linr::Field<int, 0, 6>;
+        using Name  = linr::Field<std::string, 6, 10>;
+        using Price = linr::Field<double, 16, 8>;
+
+        auto result = linr::detail::parse_fixed<Price, Id, Name>("    42ann smith    12.5");
+        expect(result and *result == std::tuple{ 12.5, 42, std::string{ "ann smith" } });
+
+        auto invalid = linr::detail::parse_fixed<Id, Price>("    42ann smith");
+        expect(not invalid and invalid.error() == linr::Error::InvalidInput);
+    };
+
+    "csv fields are unquoted and quoted delimiters are kept"_test = [] {
+        auto unescaped = std::string{};
+        auto fields    = linr::detail::split_csv<4>(R"(1,"a, b","say ""hi""",,x)", ',', unescaped);
+        expect(fields and *fields == std::array<linr::Str, 4>{ "1", "a, b", R"(say "hi")", "" });
+
+        auto missing = linr::detail::split_csv<3>(R"(1,"2,3")", ',', unescaped);
+        expect(not missing);
+    };
+
+    "aggregates are parsed member by member from consecutive fields"_test = [] {
+        static_assert(linr::detail::Reflectable<Point> and not linr::detail::Reflectable<Idk>);
+
+        // neither can be tied member by member (see `tie_members`)
+        struct Array
+        {
+            int m_xy[2];
+            int m_z;
+        };
+        struct Derived : Point
+        {
+            int m_z;
+        };
+        static_assert(linr::detail::paren_initializable<Point, linr::detail::member_count<Point>>);
+        static_assert(not linr::detail::paren_initializable<Array, linr::detail::member_count<Array>>);
+        static_assert(not linr::detail::paren_initializable<Derived, linr::detail::member_count<Derived>>);
+
+        auto result = linr::detail::parse_line<Point, int>("1 2.5 3", ' ');
+        expect(result and std::get<0>(*result).m_x == 1 and std::get<0>(*result).m_y == 2.5f);
+        expect(result and std::get<1>(*result) == 3);
+
+        auto missing = linr::detail::parse_line<Point>("1", ' ');
+        expect(not missing and missing.error() == linr::Error::InvalidInput);
+    };
+
+    "cursor parsers take their tokens from the scan of the line"_test = [] {
+        static_assert(linr::CursorParseable<Segment> and not linr::Parseable<Segment>);
+
+        auto result = linr::detail::parse_line<int, Segment, int>("0 1 2.5 -> 3 4 5", ' ');
+        expect(result and std::get<1>(*result).m_from.m_y == 2.5f and std::get<1>(*result).m_to.m_x == 3);
+        expect(result and std::get<0>(*result) == 0 and std::get<2>(*result) == 5);
+
+        auto invalid = linr::detail::parse_line<Segment>("1 2 3 4", ' ');
+        expect(not invalid and invalid.error() == linr::Error::InvalidInput);
+    };
+
+    "embedded tables are parsed at compile time"_test = [] {
+        constexpr auto table = linr::parse_static<"1 0.5 true\n-2 1e-3 false\n\n", int, double, bool>();
+
+        static_assert(table.size() == 2);
+        static_assert(std::get<0>(table[1]) == -2 and std::get<1>(table[1]) == 1e-3);
+        static_assert(std::get<2>(table[0]) and not std::get<2>(table[1]));
+        static_assert(linr::parse<std::uint8_t>("256").error() == linr::Error::OutOfRange);
+    };
+
+    "fixed strings are stored inline and reject longer fields"_test = [] {
+        expect(linr::parse<linr::FixedString<4>>("AAPL").value() == "AAPL");
+        expect(linr::parse<linr::FixedString<4>>("").value().empty());
+        expect(linr::parse<linr::FixedString<4>>("GOOGL").error() == linr::Error::OutOfRange);
+    };
+
+    "borrowed values view the parsed string without copying"_test = [] {
+        auto str    = std::string_view{ "borrowed" };
+        auto result = linr::parse<linr::Borrowed>(str);
+        expect(result and result->data() == str.data() and *result == str);
+    };
+
+    "formats match literals and whitespace around values"_test = [] {
+        using linr::detail::parse_format;
+
+        auto mixed = parse_format<"{}:{}, {}", int, double, std::string>("1:2.5, abc");
+        expect(mixed and *mixed == linr::Tup<int, double, std::string>{ 1, 2.5, "abc" });
+
+        auto braces = parse_format<"{{{}}}", int>("{42}");
+        expect(braces and std::get<0>(*braces) == 42);
+
+        auto spaces = parse_format<"{} {}", int, int>("1 \t  2");
+        expect(spaces and *spaces == linr::Tup<int, int>{ 1, 2 });
+
+        // the first value ends at whitespace, not at the '=' of the literal after the next value
+        auto later = parse_format<"{} {}=x", std::string, std::string>("a=b c=x");
+        expect(later and *later == linr::Tup<std::string, std::string>{ "a=b", "c" });
+
+        auto range = parse_format<"{},{}", std::uint8_t, int>("300,1");
+        expect(not range and range.error() == linr::Error::OutOfRange);
+
+        auto crlf = parse_format<"{},{}", int, std::string>("1,ab\r\n");
+        expect(crlf and std::get<1>(*crlf) == "ab");
+    };
+
+    "every value of a line is parsed into a reused vector"_test = [] {
+        auto values = std::vector<int>{ 9, 9, 9, 9 };
+
+        auto trailing = linr::detail::parse_values("1 2 3  ", ' ', values);
+        expect(trailing and *trailing == 3 and values == std::vector{ 1, 2, 3 });
+
+        auto empty = linr::detail::parse_values("", ' ', values);
+        expect(empty and *empty == 0 and values.empty());
+
+        auto invalid = linr::detail::parse_values("4 5 x 6", ' ', values);
+        expect(not invalid and invalid.error() == linr::Error::InvalidInput);
+        expect(values == std::vector{ 4, 5 });
+
+        // the strings are allocated from the resource of the vector
+        auto buffer   = std::array<std::byte, 1024>{};
+        auto resource = std::pmr::monotonic_buffer_resource{ buffer.data(), buffer.size() };
+        auto strings  = std::pmr::vector<std::pmr::string>{ &resource };
+
+        auto parsed = linr::detail::parse_values("a-string-longer-than-sso b", ' ', strings);
+        expect(parsed and *parsed == 2 and strings[0] == "a-string-longer-than-sso");
+        expect(strings[0].get_allocator().resource() == &resource);
+
+        auto* data = reinterpret_cast<const std::byte*>(strings[0].data());
+        expect(data >= buffer.data() and data < buffer.data() + buffer.size());
+    };
+
+    "bulk parsing skips empty lines"_test = [] {
+        auto result = linr::detail::parse_chunks<int, int>("1 2\r\n\n3 4\n\n", 4, ' ');
+        expect(result and *result == std::vector<linr::Tup<int, int>>{ { 1, 2 }, { 3, 4 } });
+
+        auto invalid = linr::detail::parse_chunks<int, int>("1 2\n3\n", 4, ' ');
+        expect(not invalid and invalid.error() == linr::Error::InvalidInput);
+    };
+
+    "read_columns skips empty lines and rolls back an invalid row"_test = [] {
+        auto reader  = MemReader{ { "1 2\r\n", "\n", "3 4\n", "\r\n", "5 6" } };
+        auto columns = linr::Tup<std::vector<int>, std::vector<int>>{};
+        auto result  = linr::detail::read_columns_impl<int, int>(reader, columns, ' ');
+        expect(result and *result == 3);
+        expect(std::get<0>(columns) == std::vector{ 1, 3, 5 });
+        expect(std::get<1>(columns) == std::vector{ 2, 4, 6 });
+
+        // the first value of the invalid row is parsed, then removed
+        auto invalid_rows = MemReader{ { "7 8\n", "9 x\n" } };
+        auto invalid = linr::detail::read_columns_impl<int, int>(invalid_rows, columns, ' ');
+        expect(not invalid and invalid.error() == linr::Error::InvalidInput);
+        expect(std::get<0>(columns) == std::vector{ 1, 3, 5, 7 });
+        expect(std::get<1>(columns) == std::vector{ 2, 4, 6, 8 });
+    };
+
+#if defined(LINR_ENABLE_ZLIB)
+    "gzip decoder decodes concatenated members"_test = [] {
+        auto first   = gzip("1 2\n");
+        auto second  = gzip("3 4\n");
+        auto members = first + second;
+
+        auto input   = linr::detail::BasicCompressedInput<ChunkSource>{ ChunkSource{ { members } } };
+        auto decoder = linr::detail::GzipDecoder{};
+        auto decode  = [&](char* out, std::size_t size) { return decoder.decode(input, out, size); };
+        expect(read_all(decode) == "1 2\n3 4\n");
+    };
+
+    "decompress source detects the format across pipe reads"_test = [] {
+        using Source = linr::detail::BasicDecompressSource<ChunkSource>;
+
+        auto plain = Source{ ChunkSource{ { "1", " 2\n", "3 4\n" } } };
+        expect(read_all([&](char* out, std::size_t size) { return plain.read(out, size); }) == "1 2\n3 4\n");
+
+        // the magic bytes are split across reads, and so is the boundary between the members
+        auto members = gzip("1 2\n") + gzip("3 4\n");
+        auto chunks  = std::vector<linr::Str>{};
+        for (auto i = std::size_t{ 0 }; i < members.size(); i += 3) {
+            chunks.push_back(linr::Str{ members }.substr(i, 3));
+        }
+
+        auto gzipped = Source{ ChunkSource{ chunks } };
+        auto read    = [&](char* out, std::size_t size) { return gzipped.read(out, size); };
+        expect(read_all(read) == "1 2\n3 4\n");
+    };
+#endif
+
+    "pipeline delivers the batches in input order"_test = [] {
+        auto pipeline = linr::BasicPipeline<CountReader, int, int>{ 4, ' ', 7, 3 };
+        auto expected = std::uint64_t{ 0 };
+        auto ordered  = true;
+
+        auto lines = pipeline.run([&](auto& batch) {
+            ordered = ordered and batch.first_line() == expected;
+            for (auto& record : batch) {
+                auto value = static_cast<int>(expected++);
+                ordered    = ordered and record and *record == linr::Tup<int, int>{ value, -value };
+            }
+        });
+        expect(ordered and lines == 1000 and expected == 1000);
+    };
+
+    "pipeline stops when the callback returns false"_test = [] {
+        auto pipeline = linr::BasicPipeline<CountReader, int, int>{ 4, ' ', 7, 3 };
+        auto batches  = 0;
+
+        auto lines = pipeline.run([&](auto& batch) {
+            ++batches;
+            return batch.seq() < 1;
+        });
+        expect(batches == 2 and lines == 14);
+    };
+}
+
+// reads a file through every reader backend, stdin is reopened on the file (so it runs after the stdin tests)
+void test_readers()
+{
+    using namespace ut::literals;
+    using ut::expect;
+
+    // larger than the blocks of the readers: lines cross the block boundaries and the last read is short
+    constexpr auto lines = 100'000;
+
+    auto path = std::filesystem::temp_directory_path() / "linr-test-readers.txt";
+    auto text = std::string{};
+    for (auto i = 0; i < lines; ++i) {
+        text += fmt::format("{} {}\n", i, -i);
+    }
+    text += "end";    // no newline at EOF
+
+    if (auto* file = std::fopen(path.c_str(), "w")) {
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fclose(file);
+    }
+
+    // the reader is made once stdin is reopened, some readers start reading (or map stdin) when constructed
+    const auto read_file = [&](auto make) {
+        if (not std::freopen(path.c_str(), "r", stdin)) {
+            return false;
+        }
+
+        auto reader = make();
+        auto valid  = true;
+        for (auto i = 0; i < lines and valid; ++i) {
+            auto value = reader.template read<int, int>();
+            valid      = value and *value == linr::Tup<int, int>{ i, -i };
+        }
+
+        auto last = reader.read();
+        return valid and last and *last == "end" and not reader.read();
+    };
+
+    "BufReader reads a file"_test = [&] { expect(read_file([] { return linr::BufReader{ 1024 }; })); };
+
+#if defined(__unix__) or defined(__APPLE__)
+    "BlockReader reads a file"_test = [&] { expect(read_file([] { return linr::BlockReader{}; })); };
+    "PrefetchReader reads a file"_test = [&] { expect(read_file([] { return linr::PrefetchReader{}; })); };
+    "MappedReader reads a file"_test = [&] { expect(read_file([] { return linr::MappedReader{}; })); };
+#endif
+
+#if defined(__linux__) and defined(LINR_ENABLE_IO_URING)
+    "UringReader reads a file"_test = [&] { expect(read_file([] { return linr::UringReader{}; })); };
+#endif
+
+    std::filesystem::remove(path);
+}
+
 int main()
 {
+    test_parse();
+
     test([]<typename... T>(std::string_view prompt, char delim = ' ') {
         if constexpr (sizeof...(T) == 0) {
             return linr::read(prompt);
@@ -148,4 +647,6 @@ int main()
             return reader.read<T...>(prompt, delim);
         }
     });
+
+    test_readers();
 }